@@ -0,0 +1,131 @@
+#include <rp6502.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "constants.h"
+#include "asset.h"
+#include "xram.h"
+
+typedef struct {
+    char magic[2];        // "LZ"
+    uint16_t raw_size;
+    uint16_t stream_size; // Tokens, end token included
+} lz_header_t;
+
+// Read the header and the packed stream, into ASSET_SCRATCH_ADDR
+static bool load_stream(const char *filename, lz_header_t *h)
+{
+    uint16_t got = 0;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("asset: Failed to open %s\n", filename);
+        return false;
+    }
+
+    bool ok = read(fd, h, sizeof(*h)) == sizeof(*h)
+        && h->magic[0] == 'L' && h->magic[1] == 'Z'
+        && h->stream_size <= ASSET_SCRATCH_SIZE;
+
+    // read_xram may come back short; keep going until the stream is in
+    while (ok && got < h->stream_size) {
+        int n = read_xram(ASSET_SCRATCH_ADDR + got, h->stream_size - got, fd);
+        if (n <= 0) ok = false;
+        else got += n;
+    }
+    close(fd);
+
+    if (!ok) printf("asset: Bad LZ file %s\n", filename);
+    return ok;
+}
+
+static void report(const char *filename, const lz_header_t *h, uint16_t size, uint8_t start)
+{
+    printf("asset: %-16s %5u -> %5u bytes, +%u vsync\n", filename,
+           h->stream_size + (uint16_t)sizeof(*h), size, (uint8_t)(RIA.vsync - start));
+}
+
+bool asset_unpack(const char *filename, uint16_t dst, uint16_t size)
+{
+    uint8_t start = RIA.vsync;
+    lz_header_t h;
+
+    if (!load_stream(filename, &h)) return false;
+    if (h.raw_size > size) {
+        printf("asset: %s is %u bytes, room for %u\n", filename, h.raw_size, size);
+        return false;
+    }
+
+    xram_unlz(dst, ASSET_SCRATCH_ADDR);
+    report(filename, &h, h.raw_size, start);
+    return true;
+}
+
+#ifdef INDEXED_SPRITES
+// Static, not on the soft stack: 512 bytes at boot would set the stack peak
+static uint16_t pal[256];
+
+bool asset_unpack_indexed(const char *filename, uint16_t dst, uint16_t size)
+{
+    uint8_t start = RIA.vsync;
+    lz_header_t h;
+
+    if (!load_stream(filename, &h)) return false;
+    if (h.raw_size > ASSET_SCRATCH_SIZE - h.stream_size) {
+        printf("asset: %s does not fit the scratch\n", filename);
+        return false;
+    }
+
+    // Unpack behind the stream, then read the header and palette back
+    uint16_t src = ASSET_SCRATCH_ADDR + h.stream_size;
+    xram_unlz(src, ASSET_SCRATCH_ADDR);
+
+    RIA.addr1 = src;
+    RIA.step1 = 1;
+    uint8_t bpp = RIA.rw1;
+    uint16_t colours = RIA.rw1;
+    if (colours == 0) colours = 256;
+    if (h.raw_size < 2 + 2 * colours) {
+        printf("asset: Bad indexed sprite %s\n", filename);
+        return false;
+    }
+
+    // Indices past the palette come out as 0, transparent, not as the
+    // previous sprite's colours
+    for (uint16_t i = 0; i < 256; i++) {
+        if (i < colours) {
+            uint8_t lo = RIA.rw1;
+            pal[i] = lo | (RIA.rw1 << 8);
+        } else {
+            pal[i] = 0;
+        }
+    }
+    uint16_t count = h.raw_size - 2 - 2 * colours; // Index bytes
+    uint16_t out = (bpp == 4) ? count * 4 : count * 2;
+    if (out > size) {
+        printf("asset: %s expands to %u bytes, room for %u\n", filename, out, size);
+        return false;
+    }
+
+    // Indices stream in through portal 1, RGB555 pixels out through 0
+    RIA.addr0 = dst;
+    RIA.step0 = 1;
+    while (count--) {
+        uint8_t b = RIA.rw1;
+        uint16_t c;
+        if (bpp == 4) {
+            c = pal[b >> 4];
+            RIA.rw0 = c & 0xFF;
+            RIA.rw0 = c >> 8;
+            b &= 0x0F;
+        }
+        c = pal[b];
+        RIA.rw0 = c & 0xFF;
+        RIA.rw0 = c >> 8;
+    }
+
+    report(filename, &h, out, start);
+    return true;
+}
+#endif
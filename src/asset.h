@@ -0,0 +1,33 @@
+#ifndef ASSET_H
+#define ASSET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Packed XRAM assets (PACKED_ASSETS builds)
+ * Sprite art ships as ROM files in the LZ container of tools/lz_pack.py
+ * instead of raw rp6502_asset images. asset_unpack reads the packed
+ * stream into XRAM scratch and xram_unlz expands it in place; nothing
+ * passes through 6502 RAM but the 6-byte header.
+ *
+ * The scratch is the galaxy bitmap, so unpack before the boot clear.
+ */
+
+#define ASSET_SCRATCH_ADDR XRAM_BITMAP_ADDR
+#define ASSET_SCRATCH_SIZE XRAM_BITMAP_SIZE
+
+// Unpack filename to dst, which holds size bytes. Prints the packed and
+// unpacked sizes and the vsyncs it took; false (and a message) on a
+// missing, corrupt or oversized file.
+bool asset_unpack(const char *filename, uint16_t dst, uint16_t size);
+
+#ifdef INDEXED_SPRITES
+// Same for an indexed sprite (convert_sprite.py --indexed): unpacks it in
+// the scratch behind the stream, then expands the 4bpp or 8bpp indices
+// through its palette into RGB555 pixels at dst. Mode 4 sprites only
+// read RGB555, so this saves ROM and load time, not XRAM.
+bool asset_unpack_indexed(const char *filename, uint16_t dst, uint16_t size);
+#endif
+
+#endif // ASSET_H
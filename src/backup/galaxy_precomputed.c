@@ -6,6 +6,7 @@
 #include "galaxy_precomputed.h"
 #include "graphics.h"
 #include "constants.h"
+#include "xram.h"
 
 // Delta change format: (old_x, old_y, new_x, new_y, color)
 typedef struct {
@@ -79,11 +80,7 @@ static bool start_next_frame(void) {
 void galaxy_precomputed_draw(void) {
     // One-time screen clear on init
     if (first_draw) {
-        RIA.addr0 = 0;
-        RIA.step0 = 1;
-        for (unsigned i = 0; i < BITMAP_SIZE; i++) {
-            RIA.rw0 = 0;
-        }
+        xram_fill(0, BITMAP_SIZE, 0);
         first_draw = false;
         start_next_frame();
         load_buffer();
@@ -5,6 +5,7 @@
 #include "opl.h"
 #include "instruments.h"
 #include "galaxy_precomputed.h"
+#include "xram.h"
 
 #define SONG_HZ 60
 
@@ -31,11 +32,7 @@ static void init_graphics(void)
     xregn(1, 0, 1, 4, 3, 3, BITMAP_CONFIG, 1);
 
     // Clear bitmap memory
-    RIA.addr0 = 0;
-    RIA.step0 = 1;
-    for (unsigned i = 0; i < BITMAP_SIZE; i++) {
-        RIA.rw0 = 0;
-    }
+    xram_fill(0, BITMAP_SIZE, 0);
 
 }
 
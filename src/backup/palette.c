@@ -2,6 +2,7 @@
 #include <stdint.h>
 #include "constants.h"
 #include "palette.h"
+#include "xram.h"
 
 // 128-color Blue-Cyan-White gradient, mirrored to indices 128-255
 static const uint16_t galaxy_palette_base[128] = {
@@ -25,14 +26,7 @@ static const uint16_t galaxy_palette_base[128] = {
 
 void palette_init(void)
 {
-    RIA.addr0 = PALETTE_ADDR;
-    RIA.step0 = 1;
-    for (uint16_t i = 0; i < 128; i++) {
-        RIA.rw0 = galaxy_palette_base[i] & 0xFF;
-        RIA.rw0 = galaxy_palette_base[i] >> 8;
-    }
-    for (uint16_t i = 0; i < 128; i++) {
-        RIA.rw0 = galaxy_palette_base[i] & 0xFF;
-        RIA.rw0 = galaxy_palette_base[i] >> 8;
-    }
+    // Little Endian in RAM, same as the XRAM palette
+    xram_upload(PALETTE_ADDR, galaxy_palette_base, sizeof(galaxy_palette_base));
+    xram_upload(PALETTE_ADDR + sizeof(galaxy_palette_base), galaxy_palette_base, sizeof(galaxy_palette_base));
 }
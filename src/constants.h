@@ -1,11 +1,24 @@
+#include "xram_map.h" // Generated from src/xram.layout
 
 #define SCREEN_WIDTH 320U
 #define SCREEN_HEIGHT 180U
-#define BITMAP_SIZE (SCREEN_WIDTH * SCREEN_HEIGHT)
-#define PALETTE_ADDR 0xE100U      // 512 Bytes (0xE100 - 0xE300)
-#define BITMAP_CONFIG_ADDR 0xE300U // 16 Bytes (0xE300 - 0xE310)
-#define PIXEL_DATA_ADDR 0x0000U // Pixel data starts at 0
+#ifdef GALAXY_4BPP
+// 2-bit pink, 2-bit cyan per pixel, two pixels per byte (high nibble left).
+// The bitmap ends at 0x7080, leaving 0x7080-0xE100 free.
+#define BITMAP_BPP 4
+#define BITMAP_MODE3_ATTR 2
+#else
+// 4-bit pink, 4-bit cyan per pixel
+#define BITMAP_BPP 8
+#define BITMAP_MODE3_ATTR 3
+#endif
+#define BITMAP_STRIDE (SCREEN_WIDTH * BITMAP_BPP / 8)
+#define BITMAP_SIZE (BITMAP_STRIDE * SCREEN_HEIGHT)
 
-#define OPL_ADDR        0xFE00  // OPL2 Address port
-#define GAMEPAD_INPUT   0xFF78  // XRAM address for gamepad data
-#define KEYBOARD_INPUT  0xFFA0  // XRAM address for keyboard data
\ No newline at end of file
+#define PALETTE_ADDR       XRAM_PALETTE_ADDR
+#define BITMAP_CONFIG_ADDR XRAM_BITMAP_CONFIG_ADDR
+#define PIXEL_DATA_ADDR    XRAM_BITMAP_ADDR
+
+#define OPL_ADDR        XRAM_OPL_ADDR      // OPL2 Address port
+#define GAMEPAD_INPUT   XRAM_GAMEPAD_ADDR  // XRAM address for gamepad data
+#define KEYBOARD_INPUT  XRAM_KEYBOARD_ADDR // XRAM address for keyboard data
\ No newline at end of file
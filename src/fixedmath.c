@@ -0,0 +1,80 @@
+#include <stdint.h>
+#include "fixedmath.h"
+#include "tables.h"
+
+uint8_t vector_to_angle(int16_t x, int16_t y) {
+    if (x == 0 && y == 0) return 0;
+    
+    // Determine Octant
+    uint16_t abs_x = (x < 0) ? -x : x;
+    uint16_t abs_y = (y < 0) ? -y : y;
+    
+    uint16_t max_val = (abs_x > abs_y) ? abs_x : abs_y;
+    uint16_t min_val = (abs_x > abs_y) ? abs_y : abs_x;
+    
+    // 1. Reduce to First Octant (0..45 degrees)
+    // Normalise to 8 bits (at most 7 shifts) so both index the log table.
+    while (max_val > 255) {
+        max_val >>= 1;
+        min_val >>= 1;
+    }
+    
+    // atan(min / max) = ATAN_LUT[log2(max) - log2(min)]. Result 0..32.
+    uint8_t base_angle = 0;
+    if (min_val > 0) {
+        base_angle = ATAN_LUT[(uint8_t)(LOG2_LUT[max_val] - LOG2_LUT[min_val])];
+    }
+    
+    // 2. Map back to correct Octant
+    // 0=Right, 64=Down, 128=Left, 192=Up (screen Y down)
+    if (abs_x >= abs_y) {
+        // X dominant: offset from 0 or 128
+        if (x >= 0) return (y >= 0) ? base_angle : (uint8_t)(256 - base_angle);
+        else        return (y >= 0) ? (uint8_t)(128 - base_angle) : (uint8_t)(128 + base_angle);
+    } else {
+        // Y dominant: offset from 64 or 192
+        if (y >= 0) return (x >= 0) ? (uint8_t)(64 - base_angle) : (uint8_t)(64 + base_angle);
+        else        return (x >= 0) ? (uint8_t)(192 + base_angle) : (uint8_t)(192 - base_angle);
+    }
+}
+
+uint8_t div_one_plus(uint8_t a, uint8_t e) {
+    // RECIP is 256 only at e == 0, which is exact (a * 256 >> 8); every
+    // other entry fits a byte, so this is one 8x8 quarter-square multiply
+    // rather than the compiler's 16x16 __mulhi3.
+    if (e == 0) return a;
+    return (uint8_t)(umul8x8(a, (uint8_t)RECIP_1PE_LUT[e]) >> 8);
+}
+
+uint8_t orbit_speed(uint8_t radius) {
+    return ORBIT_SPEED_LUT[radius];
+}
+
+uint16_t umul8x8(uint8_t a, uint8_t b) {
+    uint16_t sum = (uint16_t)a + b;
+    uint8_t diff = (a >= b) ? (uint8_t)(a - b) : (uint8_t)(b - a);
+    
+    uint16_t sq_sum  = ((uint16_t)SQR_HI[sum] << 8) | SQR_LO[sum];
+    uint16_t sq_diff = ((uint16_t)SQR_HI[diff] << 8) | SQR_LO[diff];
+    return sq_sum - sq_diff;
+}
+
+int16_t smul8x8(int8_t a, int8_t b) {
+    // |-128| = 128 still fits uint8; 128 * 128 fits int16
+    uint8_t ua = (a < 0) ? (uint8_t)-a : (uint8_t)a;
+    uint8_t ub = (b < 0) ? (uint8_t)-b : (uint8_t)b;
+    int16_t p = (int16_t)umul8x8(ua, ub);
+    return ((a ^ b) < 0) ? -p : p;
+}
+
+uint32_t umul16x8(uint16_t a, uint8_t b) {
+    // (hi * b) << 8 + lo * b
+    return ((uint32_t)umul8x8((uint8_t)(a >> 8), b) << 8) + umul8x8((uint8_t)a, b);
+}
+
+int32_t smul16x8(int16_t a, int8_t b) {
+    uint16_t ua = (a < 0) ? (uint16_t)-a : (uint16_t)a;
+    uint8_t ub = (b < 0) ? (uint8_t)-b : (uint8_t)b;
+    int32_t p = (int32_t)umul16x8(ua, ub);
+    return ((a < 0) != (b < 0)) ? -p : p;
+}
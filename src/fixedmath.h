@@ -0,0 +1,33 @@
+#ifndef FIXEDMATH_H
+#define FIXEDMATH_H
+
+#include <stdint.h>
+
+/*
+ * Table-driven fixed-point helpers (tables from tools/gen_tables.py).
+ * No division, no 32-bit math: these replace the compiler's
+ * __udivhi3/__divsi3 helpers on the spawn paths.
+ */
+
+// Calculate angle 0..255 from vector x,y (0 = +X, 64 = +Y)
+// atan2 via log2/atan tables. Max error ~1 unit (1.4 degrees).
+uint8_t vector_to_angle(int16_t x, int16_t y);
+
+// a / (1 + e/256), i.e. (a * 256) / (256 + e), within 1 of the division
+uint8_t div_one_plus(uint8_t a, uint8_t e);
+
+// Keplerian base speed 3500 / radius, clamped 20..255
+uint8_t orbit_speed(uint8_t radius);
+
+/*
+ * Quarter-square multiplies: a*b = SQR[a+b] - SQR[|a-b|].
+ * 8x8 is four page-aligned table reads and a 16-bit subtract, in place
+ * of the compiler's shift-add __mulhi3 loop. 16x8 is two 8x8 products.
+ * Results are exact.
+ */
+uint16_t umul8x8(uint8_t a, uint8_t b);
+int16_t  smul8x8(int8_t a, int8_t b);
+uint32_t umul16x8(uint16_t a, uint8_t b); // 24-bit result
+int32_t  smul16x8(int16_t a, int8_t b);   // 24-bit result
+
+#endif // FIXEDMATH_H
@@ -1,33 +1,110 @@
 #include <rp6502.h>
 #include <stdint.h>
 #include <stdlib.h> // for abs
+#include <stdio.h>
 #include "galaxy.h"
 #include "tables.h"
 #include "constants.h"
 #include "graphics.h"
 #include "sprites.h" // For enemies/workers
+#include "fixedmath.h"
+#include "xram.h"
+#ifdef USE_ASM_PARTICLES
+#include <stddef.h> // offsetof
+#include "galaxy_kernel.h"
+#endif
+#ifdef GALAXY_STREAM
+#include "galaxy_stream.h"
+#endif
+
+#ifdef GALAXY_HALF_RES
+// Half-resolution accumulation: the attractor runs on a 160x90 grid and
+// each cell is drawn as a 2x2 block of the 320x180 bitmap. Mode 3 has no
+// scaler, so the doubling is done by the splat and decay here.
+#define GALAXY_SHIFT 1
+#else
+#define GALAXY_SHIFT 0
+#endif
+#define GALAXY_WIDTH  (SCREEN_WIDTH >> GALAXY_SHIFT)
+#define GALAXY_HEIGHT (SCREEN_HEIGHT >> GALAXY_SHIFT)
 
 // #define N 64 (Replaced by N 80 below)
-#define SCALE 60 // Screen scale factor
+#define SCALE (60 >> GALAXY_SHIFT) // Screen scale factor
 #define T_INC 5 // 0.2 in 8.8 fixed point
 
 // Globals
 static int16_t x, y, t;
 
-// Explosion State
-static bool exp_active = false;
-static int16_t exp_x = 0;
-static int16_t exp_y = 0;
-static uint8_t exp_type = 0;
-static uint8_t exp_timer = 0;
+// Explosion State: a small ring, a new blast replaces the oldest
+#define MAX_EXPLOSIONS 4 // Power of two
+#define EXP_RADIUS (32 >> GALAXY_SHIFT) // Box 64x64
+#define EXP_FRAMES 21
+
+// Every particle step lands within this many grid units of the centre
+// (|u|, |v| <= 512), which bounds where a blast can have any effect.
+// That box is columns 40..280 and every row, so it only rules out blasts
+// centred within 8 px of the left or right edge. The attractor gives no
+// tighter bound for a slice before its steps are computed, so a per-slice
+// early-out is not possible: in practice exp_active means "a blast is
+// live", for all 21 frames of it.
+#define GALAXY_REACH ((512 * SCALE) >> 8)
+
+typedef struct {
+    int16_t x0, x1, y0, y1; // Galaxy grid coordinates, inclusive
+} exp_box_t;
+
+typedef struct {
+    exp_box_t box;
+    uint8_t type;
+    uint8_t timer; // Frames left, 0 = free
+} explosion_t;
+
+static explosion_t explosions[MAX_EXPLOSIONS];
+static uint8_t exp_head = 0;   // Next slot to fill, also the oldest
+static bool exp_active = false; // A live blast overlaps the reach box (nearly any blast)
+static exp_box_t exp_bounds;   // Union of the live boxes
+
+// Shockwave jitter: 8-bit xorshift (1,1,2), period 255
+static uint8_t exp_rng = 1;
+
+static inline int8_t exp_jitter(void) {
+    exp_rng ^= exp_rng << 1;
+    exp_rng ^= exp_rng >> 1;
+    exp_rng ^= exp_rng << 2;
+    return (int8_t)(exp_rng & 7) - 3;
+}
+
+// Refresh exp_bounds and exp_active after blasts start or expire
+static void explosions_update(void) {
+    exp_bounds.x0 = exp_bounds.y0 = INT16_MAX;
+    exp_bounds.x1 = exp_bounds.y1 = INT16_MIN;
+    for (uint8_t k = 0; k < MAX_EXPLOSIONS; k++) {
+        const explosion_t *e = &explosions[k];
+        if (!e->timer) continue;
+        if (e->box.x0 < exp_bounds.x0) exp_bounds.x0 = e->box.x0;
+        if (e->box.x1 > exp_bounds.x1) exp_bounds.x1 = e->box.x1;
+        if (e->box.y0 < exp_bounds.y0) exp_bounds.y0 = e->box.y0;
+        if (e->box.y1 > exp_bounds.y1) exp_bounds.y1 = e->box.y1;
+    }
+    exp_active = exp_bounds.x1 >= (int16_t)(GALAXY_WIDTH / 2) - GALAXY_REACH &&
+                 exp_bounds.x0 <= (int16_t)(GALAXY_WIDTH / 2) + GALAXY_REACH &&
+                 exp_bounds.y1 >= (int16_t)(GALAXY_HEIGHT / 2) - GALAXY_REACH &&
+                 exp_bounds.y0 <= (int16_t)(GALAXY_HEIGHT / 2) + GALAXY_REACH;
+}
 
 void galaxy_explosion(int16_t x, int16_t y, uint8_t type) {
-    if (exp_active) return; // Only one active at a time for simplicity
-    exp_active = true;
-    exp_x = x;
-    exp_y = y;
-    exp_type = type;
-    exp_timer = 20; // Last for 20 frames
+    explosion_t *e = &explosions[exp_head];
+    exp_head = (exp_head + 1) & (MAX_EXPLOSIONS - 1);
+
+    x >>= GALAXY_SHIFT; // Galaxy grid coordinates
+    y >>= GALAXY_SHIFT;
+    e->box.x0 = x - (EXP_RADIUS - 1);
+    e->box.x1 = x + (EXP_RADIUS - 1);
+    e->box.y0 = y - (EXP_RADIUS - 1);
+    e->box.y1 = y + (EXP_RADIUS - 1);
+    e->type = type;
+    e->timer = EXP_FRAMES;
+    explosions_update();
 }
 
 // Helper to wrap angle to 0-255 for LUT access
@@ -37,57 +114,39 @@ void galaxy_explosion(int16_t x, int16_t y, uint8_t type) {
 
 
 
-// RP6502 Color Format: BBBBB GGGGG A RRRRR
-// Bits: 15-11 (Blue), 10-6 (Green), 5 (Alpha), 4-0 (Red)
-#define COLOR_FROM_RGB8(r,g,b) (((b>>3)<<11)|((g>>3)<<6)|(r>>3))
-#define COLOR_ALPHA_MASK (1u<<5)
+#define N 80 // Increased density
 
-static void setup_palette(void) {
-    RIA.addr0 = PALETTE_ADDR;
-    RIA.step0 = 1;
-    
-    // Hubble Palette (Teal & Gold)
-    
-    // Channel 1 (Pink var): Gold/Hydrogen (Rust -> Gold -> Pale Yellow)
-    const uint8_t P_R[] = {20, 40, 60, 80, 100, 130, 160, 190, 210, 225, 235, 245, 250, 252, 255, 255};
-    const uint8_t P_G[] = {5,  10, 20, 30,  45,  60,  80, 100, 120, 140, 160, 180, 200, 220, 240, 255};
-    const uint8_t P_B[] = {0,   0,  0,  5,  10,  15,  25,  35,  50,  65,  85, 105, 130, 160, 190, 220};
-
-    // Channel 2 (Cyan var): Azure/Oxygen (Deep Blue -> Teal -> Ice Blue)
-    const uint8_t C_R[] = {0,   0,  0,  0,   5,  10,  20,  30,  45,  60,  80, 100, 130, 160, 190, 220};
-    const uint8_t C_G[] = {5,  15, 30, 50,  70,  90, 110, 130, 150, 170, 190, 210, 225, 235, 245, 255};
-    const uint8_t C_B[] = {20, 40, 60, 80, 100, 125, 150, 175, 200, 215, 225, 235, 245, 250, 252, 255};
-
-    for (int i = 0; i < 256; i++) {
-        uint8_t pink = (i >> 4) & 0x0F;
-        uint8_t cyan = i & 0x0F;
-        
-        // Additive Mixing
-        uint16_t r_sum = P_R[pink] + C_R[cyan];
-        uint16_t g_sum = P_G[pink] + C_G[cyan];
-        uint16_t b_sum = P_B[pink] + C_B[cyan];
-        
-        uint8_t r = (r_sum > 255) ? 255 : (uint8_t)r_sum;
-        uint8_t g = (g_sum > 255) ? 255 : (uint8_t)g_sum;
-        uint8_t b = (b_sum > 255) ? 255 : (uint8_t)b_sum;
-        
-        // Convert to RP6502 format with Alpha set
-        // Index 0 must be transparent for Sprites
-        uint16_t color = COLOR_FROM_RGB8(r, g, b);
-        if (i > 0) color |= COLOR_ALPHA_MASK;
-        
-        // Write Little Endian
-        RIA.rw0 = color & 0xFF;
-        RIA.rw0 = (color >> 8) & 0xFF;
-    }
-}
+// BLEND_LUT modes (tables.h)
+#define BLEND_PINK     0
+#define BLEND_CYAN     1
+#define BLEND_INFECTED 2
+#define BLEND_ENRICHED 3
+
+// Particle State: 0 = Normal, 1 = Infected (Cyan Only)
+static uint8_t particle_state[N];
 
+#ifdef GALAXY_STREAM
+// Stream slices are whole galaxy_tick slices within one particle row
+_Static_assert(N == GALAXY_STREAM_N, "tools/gen_galaxy_stream.py N");
+_Static_assert(N % GALAXY_STREAM_SLICE == 0 && GALAXY_STREAM_SLICE == 8, "stream slices");
+#endif
 
+#ifdef GALAXY_ERASE_LIST
+// Erase-list rendering: instead of the STATE_DECAY sweep, each step plots a
+// single +6 pixel and remembers where. STATE_DECAY then clears the whole
+// list, ERASE_SLICE entries per tick, before the next frame draws
+// anything, so a pixel two steps land on in one frame is never wiped by
+// the other step's erase. Like the decay sweep, the erase runs in the
+// open: scanout can catch a partly drawn frame.
+#define ERASE_NONE 0xFFFF // Step landed off screen
+#define ERASE_SLICE 256   // 25 ticks per frame
 
-#define N 80 // Increased density
+static uint16_t erase_list[N * N];
+static uint16_t erase_idx; // Steps recorded this frame; the erase walks it back to 0
+#endif
 
-// Particle State: 0 = Normal, 1 = Infected (Cyan Only)
-static uint8_t particle_state[N];
+// Bytes cleared so far by galaxy_clear_step
+static uint16_t clear_idx;
 
 void galaxy_init(void)
 {
@@ -96,19 +155,30 @@ void galaxy_init(void)
     y = 0;
     t = 0;
     
-    setup_palette();
-    
-    // Clear screen
-    RIA.addr0 = PIXEL_DATA_ADDR;
-    RIA.step0 = 1;
-    for (uint16_t k = 0; k < BITMAP_SIZE; k++) {
-        RIA.rw0 = 0;
-    }
+    // The palette is an XRAM asset (tools/gen_tables.py --palette)
+    clear_idx = 0;
     
     // Initialize particles to Normal
     for (int i = 0; i < N; i++) {
         particle_state[i] = 0;
     }
+#ifdef GALAXY_ERASE_LIST
+    erase_idx = 0;
+#endif
+}
+
+_Static_assert(BITMAP_SIZE <= XRAM_BITMAP_SIZE, "bitmap outgrows BITMAP in src/xram.layout");
+
+// Clear the bitmap GALAXY_CLEAR_SLICE bytes per call, so boot never
+// blocks on the whole 57,600-byte fill (~260k cycles).
+bool galaxy_clear_step(void)
+{
+    uint16_t len = BITMAP_SIZE - clear_idx;
+    if (len > GALAXY_CLEAR_SLICE) len = GALAXY_CLEAR_SLICE;
+
+    xram_fill(PIXEL_DATA_ADDR + clear_idx, len, 0);
+    clear_idx += len;
+    return clear_idx >= BITMAP_SIZE;
 }
 
 void galaxy_randomize(uint16_t seed)
@@ -140,6 +210,326 @@ static uint8_t part_j = 0;
 static uint8_t cached_ri_idx;
 static uint8_t cached_i_rad_idx;
 
+// Step to the next outer particle i. Returns true once all N are done.
+static bool next_particle_row(void)
+{
+    part_j = 0;
+    part_i++;
+
+    if (part_i >= N) {
+        // All particles done
+        g_state = STATE_DECAY;
+        return true;
+    }
+
+    // Precompute new outer loop values
+    cached_ri_idx = (part_i * 4);
+    cached_i_rad_idx = (uint8_t)umul8x8(part_i, RAD_SCALE);
+    return false;
+}
+
+#ifdef USE_ASM_PARTICLES
+galaxy_kernel_t galaxy_kernel;
+
+// galaxy_kernel.s reads the struct with fixed offsets
+_Static_assert(offsetof(galaxy_kernel_t, t) == 4, "GK_T");
+_Static_assert(offsetof(galaxy_kernel_t, state) == 8, "GK_STATE");
+_Static_assert(offsetof(galaxy_kernel_t, lut_page) == 11, "GK_LUT");
+_Static_assert(offsetof(galaxy_kernel_t, zones) == 12, "GK_ZONES");
+_Static_assert(sizeof(kernel_zone_t) == 5, "zone stride");
+
+// Add the box |screen - c| < r to the kernel's zone list, clipped to the
+// kernel's byte-wide screen space. Boxes that miss it entirely are dropped.
+static void kernel_add_zone(int16_t cx, int16_t cy, int16_t r, uint8_t state)
+{
+    int16_t x0 = cx - (r - 1) + KERNEL_X_BIAS;
+    int16_t x1 = cx + (r - 1) + KERNEL_X_BIAS;
+    int16_t y0 = cy - (r - 1) + KERNEL_Y_BIAS;
+    int16_t y1 = cy + (r - 1) + KERNEL_Y_BIAS;
+    if (x1 < 0 || y1 < 0 || x0 > 255 || y0 > 255) return;
+
+    kernel_zone_t *z = &galaxy_kernel.zones[galaxy_kernel.zone_count++];
+    z->x0 = (x0 < 0) ? 0 : x0;
+    z->x1 = (x1 > 255) ? 255 : x1;
+    z->y0 = (y0 < 0) ? 0 : y0;
+    z->y1 = (y1 > 255) ? 255 : y1;
+    z->state = state;
+}
+
+// Same boxes, same order as the infection / healing checks in the C loop.
+// Entities only move between ticks, so once per tick is enough.
+static void kernel_build_zones(void)
+{
+    galaxy_kernel.zone_count = 0;
+    for (uint8_t k = 0; k < enemy_live_count; k++) {
+        uint8_t e = enemy_live[k];
+        kernel_add_zone((enemy_x[e] >> 4) + 8, (enemy_y[e] >> 4) + 8, 16, 1);
+    }
+    for (uint8_t k = 0; k < gardener_count; k++) {
+        uint8_t w = gardener_live[k];
+        kernel_add_zone((worker_x[w] >> 4) + 8, (worker_y[w] >> 4) + 8, 8, 2);
+    }
+}
+#endif
+
+#ifdef GALAXY_SPLAT_COALESCE
+// Splat coalescing: a slice's 3x3 patches are gathered in RAM, sorted by
+// framebuffer address (so by scanline, then column), with duplicate
+// addresses merged. The flush then reads and writes each byte once, in
+// step-1 runs. Every blend is "kill some nibbles, then saturating add", and
+// two of those compose into one, so the framebuffer matches the direct
+// path bit for bit.
+#define SPLAT_BUF_MAX (8 * 9) // One slice: 8 steps x 3x3 patch
+
+static uint8_t splat_count;
+static uint16_t splat_addr[SPLAT_BUF_MAX]; // Sorted, unique
+static uint8_t splat_keep[SPLAT_BUF_MAX];  // Nibble mask applied first
+static uint8_t splat_pink[SPLAT_BUF_MAX];  // Then saturating adds
+static uint8_t splat_cyan[SPLAT_BUF_MAX];
+
+#ifdef GALAXY_SPLAT_STATS
+galaxy_splat_stats_t galaxy_splat_stats;
+#define SPLAT_COUNT(field) galaxy_splat_stats.field++
+#else
+#define SPLAT_COUNT(field)
+#endif
+
+// Indexed by BLEND_* mode: which nibbles survive, and which one is added to
+static const uint8_t SPLAT_MODE_KEEP[4] = {0xFF, 0xFF, 0x0F, 0xF0};
+static const uint8_t SPLAT_MODE_PINK[4] = {1, 0, 0, 1};
+
+static void splat_add(uint16_t addr, uint8_t mode, uint8_t amount)
+{
+    uint8_t keep = SPLAT_MODE_KEEP[mode];
+    uint8_t pink = SPLAT_MODE_PINK[mode] ? amount : 0;
+    uint8_t cyan = SPLAT_MODE_PINK[mode] ? 0 : amount;
+    SPLAT_COUNT(contributions);
+
+    // Binary search for addr
+    uint8_t lo = 0, hi = splat_count;
+    while (lo < hi) {
+        uint8_t mid = (lo + hi) >> 1;
+        if (splat_addr[mid] < addr) lo = mid + 1;
+        else hi = mid;
+    }
+
+    if (lo < splat_count && splat_addr[lo] == addr) {
+        // Compose: a killed nibble restarts from this add, else they sum
+        if (!(keep & 0xF0)) splat_pink[lo] = pink;
+        else if ((splat_pink[lo] += pink) > 15) splat_pink[lo] = 15;
+        if (!(keep & 0x0F)) splat_cyan[lo] = cyan;
+        else if ((splat_cyan[lo] += cyan) > 15) splat_cyan[lo] = 15;
+        splat_keep[lo] &= keep;
+        return;
+    }
+
+    for (uint8_t k = splat_count; k > lo; k--) {
+        splat_addr[k] = splat_addr[k - 1];
+        splat_keep[k] = splat_keep[k - 1];
+        splat_pink[k] = splat_pink[k - 1];
+        splat_cyan[k] = splat_cyan[k - 1];
+    }
+    splat_addr[lo] = addr;
+    splat_keep[lo] = keep;
+    splat_pink[lo] = pink;
+    splat_cyan[lo] = cyan;
+    splat_count++;
+}
+
+// Apply the buffer: one read and one write per unique byte, and a portal
+// setup only where the next address is not the one the portals reached.
+static void splat_flush(void)
+{
+    for (uint8_t k = 0; k < splat_count; k++) {
+        uint16_t addr = splat_addr[k];
+        if (k == 0 || addr != splat_addr[k - 1] + 1) {
+            RIA.addr0 = addr;
+            RIA.step0 = 1;
+            RIA.addr1 = addr;
+            RIA.step1 = 1;
+            SPLAT_COUNT(runs);
+        }
+
+        uint8_t val = RIA.rw0 & splat_keep[k];
+        uint8_t pink = (val >> 4) + splat_pink[k];
+        uint8_t cyan = (val & 0x0F) + splat_cyan[k];
+        if (pink > 15) pink = 15;
+        if (cyan > 15) cyan = 15;
+        RIA.rw1 = (pink << 4) | cyan;
+        SPLAT_COUNT(writes);
+    }
+    splat_count = 0;
+}
+
+#ifdef GALAXY_SPLAT_STATS
+void galaxy_splat_report(void)
+{
+    const galaxy_splat_stats_t *s = &galaxy_splat_stats;
+    // Contributions per write to two places, without floating point. The
+    // totals pass 2^32 / 100 within seconds, so the fraction goes via 64 bits.
+    uint32_t whole = 0, frac = 0;
+    if (s->writes) {
+        whole = s->contributions / s->writes;
+        frac = (uint32_t)((uint64_t)(s->contributions % s->writes) * 100 / s->writes);
+    }
+    printf("splat: contributions %lu writes %lu runs %lu (%lu.%02lu per write)\n",
+           (unsigned long)s->contributions, (unsigned long)s->writes,
+           (unsigned long)s->runs, (unsigned long)whole, (unsigned long)frac);
+}
+#endif
+#endif
+
+#ifdef GALAXY_HALF_RES
+// Draw 3x3 Blur Patch of 2x2 blocks. Each patch row reads the blocks'
+// top-left bytes through portal 0 (step 2) and writes each result twice
+// through portal 1, then repeats the row one scanline down.
+static void splat_patch(int16_t screen_x, int16_t screen_y, uint8_t mode)
+{
+    const uint8_t *blend_edge = BLEND_LUT[mode * 2];       // +2 Neighbor
+    const uint8_t *blend_centre = BLEND_LUT[mode * 2 + 1]; // +6 Center
+    uint8_t row[3];
+
+    for (int dy = -1; dy <= 1; dy++) {
+        int16_t py = screen_y + dy;
+        if (py < 0 || py >= GALAXY_HEIGHT) continue;
+
+        // |u| <= 512 keeps screen_x within 20..140, all columns on screen
+        uint16_t addr = (uint16_t)umul16x8(SCREEN_WIDTH * 2, (uint8_t)py) + (uint16_t)(screen_x - 1) * 2;
+        RIA.addr0 = addr;
+        RIA.step0 = 2;
+        RIA.addr1 = addr;
+        RIA.step1 = 1;
+
+        for (int dx = 0; dx < 3; dx++) {
+            const uint8_t *blend = (dx == 1 && dy == 0) ? blend_centre : blend_edge;
+            uint8_t val = blend[RIA.rw0];
+            RIA.rw1 = val;
+            RIA.rw1 = val;
+            row[dx] = val;
+        }
+
+        RIA.addr1 = addr + SCREEN_WIDTH;
+        for (int dx = 0; dx < 3; dx++) {
+            RIA.rw1 = row[dx];
+            RIA.rw1 = row[dx];
+        }
+    }
+}
+#elif defined(GALAXY_4BPP)
+// Draw 3x3 Blur Patch into the 4bpp bitmap, high nibble = left pixel. A
+// row's three pixels span two bytes: each is read once through portal 0
+// and written once through portal 1, after both its nibbles are done.
+static void splat_patch(int16_t screen_x, int16_t screen_y, uint8_t mode)
+{
+    const uint8_t *blend_edge = BLEND4_LUT[mode * 2];       // +1 Neighbor
+    const uint8_t *blend_centre = BLEND4_LUT[mode * 2 + 1]; // +2 Center
+
+    for (int dy = -1; dy <= 1; dy++) {
+        int16_t py = screen_y + dy;
+        if (py < 0 || py >= SCREEN_HEIGHT) continue;
+
+        // |u| <= 512 keeps screen_x within 40..280, all columns on screen
+        uint16_t col = screen_x - 1;
+        uint16_t addr = (uint16_t)umul16x8(BITMAP_STRIDE, (uint8_t)py) + (col >> 1);
+        RIA.addr0 = addr;
+        RIA.step0 = 1;
+        RIA.addr1 = addr;
+        RIA.step1 = 1;
+
+        uint8_t val = RIA.rw0;
+        for (int dx = 0; dx < 3; dx++, col++) {
+            const uint8_t *blend = (dx == 1 && dy == 0) ? blend_centre : blend_edge;
+            if (col & 1) {
+                // Right pixel finishes the byte
+                val = (val & 0xF0) | blend[val & 0x0F];
+                RIA.rw1 = val;
+                if (dx < 2) val = RIA.rw0;
+            } else {
+                val = (val & 0x0F) | (blend[val >> 4] << 4);
+            }
+        }
+        if (col & 1) RIA.rw1 = val; // Ended on a left pixel
+    }
+}
+#else
+// Draw 3x3 Blur Patch
+static void splat_patch(int16_t screen_x, int16_t screen_y, uint8_t mode)
+{
+#ifndef GALAXY_SPLAT_COALESCE
+    const uint8_t *blend_edge = BLEND_LUT[mode * 2];       // +2 Neighbor
+    const uint8_t *blend_centre = BLEND_LUT[mode * 2 + 1]; // +6 Center
+#endif
+
+    // Row address for the top row; one multiply per patch, then
+    // step by SCREEN_WIDTH (was 9 multiplies per patch).
+    // screen_y spans about -30..210, so |top| fits 8 bits; rows
+    // above the screen wrap mod 2^16 and land back on row 0.
+    int16_t top = screen_y - 1;
+    uint16_t row_addr = (uint16_t)umul16x8(SCREEN_WIDTH, (uint8_t)((top < 0) ? -top : top));
+    if (top < 0) row_addr = -row_addr;
+    for (int dy = -1; dy <= 1; dy++, row_addr += SCREEN_WIDTH) {
+        int16_t py = screen_y + dy;
+        if (py < 0 || py >= SCREEN_HEIGHT) continue;
+
+        // Stream the row: read through portal 0, write back
+        // through portal 1. |u| <= 512 keeps screen_x within
+        // 40..280, so all three columns are always on screen.
+        uint16_t addr = (uint16_t)(screen_x - 1) + row_addr;
+#ifdef GALAXY_SPLAT_COALESCE
+        splat_add(addr, mode, 2);
+        splat_add(addr + 1, mode, (dy == 0) ? 6 : 2);
+        splat_add(addr + 2, mode, 2);
+#else
+        RIA.addr0 = addr;
+        RIA.step0 = 1;
+        RIA.addr1 = addr;
+        RIA.step1 = 1;
+
+        for (int dx = -1; dx <= 1; dx++) {
+            // Strong Accumulation (+6 Center, +2 Neighbor)
+            const uint8_t *blend = (dx == 0 && dy == 0) ? blend_centre : blend_edge;
+            RIA.rw1 = blend[RIA.rw0];
+        }
+#endif
+    }
+}
+#endif
+
+#ifdef GALAXY_ERASE_LIST
+// Plot one pixel; returns its address for the erase list.
+static uint16_t splat_pixel(int16_t screen_x, int16_t screen_y, uint8_t mode)
+{
+    if (screen_y < 0 || screen_y >= SCREEN_HEIGHT) return ERASE_NONE;
+
+    uint16_t addr = (uint16_t)umul16x8(SCREEN_WIDTH, (uint8_t)screen_y) + screen_x;
+#ifdef GALAXY_SPLAT_COALESCE
+    splat_add(addr, mode, 6);
+#else
+    RIA.addr0 = addr;
+    RIA.addr1 = addr;
+    RIA.rw1 = BLEND_LUT[mode * 2 + 1][RIA.rw0];
+#endif
+    return addr;
+}
+
+// Clear up to count of last frame's pixels, walking the list back from
+// erase_idx (write-only, portal 1). Returns true once erase_idx is back
+// at 0, where the next frame starts recording.
+static bool erase_slice(uint16_t count)
+{
+    if (count > erase_idx) count = erase_idx;
+    erase_idx -= count;
+    const uint16_t *p = &erase_list[erase_idx];
+    while (count--) {
+        uint16_t addr = *p++;
+        if (addr == ERASE_NONE) continue;
+        RIA.addr1 = addr;
+        RIA.rw1 = 0;
+    }
+    return erase_idx == 0;
+}
+#endif
+
 bool galaxy_tick(void)
 {
     // Return true if frame completed
@@ -147,35 +537,46 @@ bool galaxy_tick(void)
     
     switch (g_state) {
         case STATE_DECAY:
-             // Process 256 pixels per tick
-             // Total 28800 pixels / 256 = 112 ticks
+#ifdef GALAXY_ERASE_LIST
+            // No sweep: clear last frame's pixels from the list
+            if (erase_slice(ERASE_SLICE)) g_state = STATE_TIME;
+            return false;
+#endif
+#ifdef GALAXY_HALF_RES
+            // One grid row (two scanlines) per tick, every other row per
+            // frame: 45 ticks. The lower scanline goes first, while the
+            // upper one still holds the undecayed values.
+            {
+                uint16_t row_addr = PIXEL_DATA_ADDR + (uint16_t)umul16x8(SCREEN_WIDTH * 2, decay_pass + (decay_idx * 2));
+                xram_decay2x(row_addr + SCREEN_WIDTH, row_addr, GALAXY_WIDTH);
+                xram_decay2x(row_addr, row_addr, GALAXY_WIDTH);
+
+                if (++decay_idx >= (GALAXY_HEIGHT / 2)) {
+                    // Decay Done
+                    decay_idx = 0;
+                    decay_pass = (decay_pass + 1) & 1;
+                    g_state = STATE_TIME;
+                }
+            }
+            return false;
+#endif
+             // Process 256 bytes per tick
+             // Total 28800 bytes / 256 = 112 ticks (57 with GALAXY_4BPP)
             {
                 uint16_t end_idx = decay_idx + 256;
                 if (end_idx > (BITMAP_SIZE / 2)) end_idx = (BITMAP_SIZE / 2);
                 
-                // Set up RIA for this batch
                 // Start index + offset for current pass
                 uint16_t current_addr = PIXEL_DATA_ADDR + decay_pass + (decay_idx * 2);
                 
-                RIA.addr0 = current_addr;
-                RIA.step0 = 2; 
-                
-                for (uint16_t k = decay_idx; k < end_idx; k++) {
-                    uint8_t val = RIA.rw0;
-                    if (val > 0) {
-                        uint8_t pink = (val >> 4) & 0x0F;
-                        uint8_t cyan = val & 0x0F;
-                        
-                        // Exponential Decay (Divide by 2)
-                        // 15->7->3->1->0. Kills blobs fast.
-                        pink >>= 1;
-                        cyan >>= 1;
-                        
-                        val = (pink << 4) | cyan;
-                        RIA.addr0 -= 2; 
-                        RIA.rw0 = val;
-                    }
-                }
+#ifdef GALAXY_4BPP
+                // Same on the 2-bit channels: 3->1->0
+                xram_decay2_4bpp(current_addr, end_idx - decay_idx);
+#else
+                // Exponential Decay (Divide by 2) on both nibbles
+                // 15->7->3->1->0. Kills blobs fast.
+                xram_decay2(current_addr, end_idx - decay_idx);
+#endif
                 
                 decay_idx = end_idx;
                 
@@ -193,11 +594,11 @@ bool galaxy_tick(void)
             if (t > 1608) t -= 1608; 
             t += T_INC;
             
-            // Explosion Timer
-            if (exp_active) {
-                if (exp_timer > 0) exp_timer--;
-                else exp_active = false;
+            // Explosion Timers
+            for (uint8_t k = 0; k < MAX_EXPLOSIONS; k++) {
+                if (explosions[k].timer) explosions[k].timer--;
             }
+            explosions_update();
             
             // Prepare for particles
             part_i = 0;
@@ -217,56 +618,112 @@ bool galaxy_tick(void)
             // At 60Hz audio updates, we can do 1 tick per audio poll?
             // If music is 60hz, we have 16ms. 
             // 8 interactions * 9 pixels * overhead might be 1-2ms. Safe.
-            
+
+#ifdef USE_ASM_PARTICLES
+            // Same 8-step batches as the C loop below, handed to the
+            // assembly kernel one particle i at a time. Ticks with a blast
+            // in reach need the shockwave jitter, so those stay in C; that
+            // is every tick of the 21 frames a blast lives (GALAXY_REACH).
+            if (!exp_active) {
+                uint8_t budget = 8;
+                kernel_build_zones();
+                galaxy_kernel.t = t;
+                while (budget) {
+                    if (part_j >= N && next_particle_row()) return true; // Frame Completed
+
+                    uint8_t n = N - part_j;
+                    if (n > budget) n = budget;
+
+                    galaxy_kernel.x = x;
+                    galaxy_kernel.y = y;
+                    galaxy_kernel.ri_idx = cached_ri_idx;
+                    galaxy_kernel.i_rad_idx = cached_i_rad_idx;
+                    galaxy_kernel.state = particle_state[part_i];
+                    galaxy_kernel.pink = (part_i < (N/2));
+                    galaxy_kernel.lut_page = (uint8_t)((uintptr_t)BLEND_LUT >> 8);
+                    galaxy_particles_asm(n);
+                    x = galaxy_kernel.x;
+                    y = galaxy_kernel.y;
+                    particle_state[part_i] = galaxy_kernel.state;
+
+                    part_j += n;
+                    budget -= n;
+                }
+                return false;
+            }
+#endif
+
+#ifdef GALAXY_STREAM
+            const uint8_t *stream = NULL;
+#endif
             for (int k = 0; k < 8; k++) {
                 // If j wraps, increment i
-                if (part_j >= N) {
-                    part_j = 0;
-                    part_i++;
-                    
-                    if (part_i >= N) {
-                        // All particles done
-                        g_state = STATE_DECAY;
-                        return true; // Frame Completed
-                    }
-                    
-                    // Precompute new outer loop values
-                    cached_ri_idx = (part_i * 4);
-                    cached_i_rad_idx = (uint8_t)(((int32_t)part_i * RAD_SCALE));
+                if (part_j >= N && next_particle_row()) {
+#ifdef GALAXY_SPLAT_COALESCE
+                    splat_flush();
+#endif
+                    return true; // Frame Completed
                 }
                 
                 // Process interaction (part_i, part_j)
                 uint8_t i = part_i;
                 uint8_t j = part_j;
                 
-                // Calculation
-                uint8_t y_idx = (uint8_t)(((int32_t)y * RAD_SCALE) >> 8);
-                uint8_t x_idx = (uint8_t)(((int32_t)x * RAD_SCALE) >> 8);
-                
-                uint8_t idx_u1 = cached_i_rad_idx + y_idx;
-                uint8_t idx_u2 = cached_ri_idx + x_idx;
-                
-                int16_t u = SIN_LUT[idx_u1] + SIN_LUT[idx_u2];
-                int16_t v = SIN_LUT[(uint8_t)(idx_u1 + 64)] + SIN_LUT[(uint8_t)(idx_u2 + 64)];
-                
-                // Update Globals for next step
-                x = u + t;
-                y = v; 
-                
-                int16_t screen_x = ((u * SCALE) >> 8) + (SCREEN_WIDTH / 2);
-                int16_t screen_y = ((v * SCALE) >> 8) + (SCREEN_HEIGHT / 2);
+                int16_t screen_x, screen_y;
+
+#ifdef GALAXY_STREAM
+                // Precomputed position, stored from the reach box corner.
+                // Live math below if the stream is not open.
+                if (k == 0) stream = galaxy_stream_slice();
+                if (stream) {
+                    screen_x = (int16_t)*stream++ + (GALAXY_WIDTH / 2 - GALAXY_REACH);
+                    screen_y = (int16_t)*stream++ + (GALAXY_HEIGHT / 2 - GALAXY_REACH);
+                } else
+#endif
+                {
+                    // Calculation
+                    uint8_t y_idx = (uint8_t)(smul16x8(y, RAD_SCALE) >> 8);
+                    uint8_t x_idx = (uint8_t)(smul16x8(x, RAD_SCALE) >> 8);
+
+                    uint8_t idx_u1 = cached_i_rad_idx + y_idx;
+                    uint8_t idx_u2 = cached_ri_idx + x_idx;
+
+                    int16_t u = SIN_LUT[idx_u1] + SIN_LUT[idx_u2];
+                    int16_t v = SIN_LUT[(uint8_t)(idx_u1 + 64)] + SIN_LUT[(uint8_t)(idx_u2 + 64)];
+
+                    // Update Globals for next step
+                    x = u + t;
+                    y = v;
+
+                    screen_x = (int16_t)(smul16x8(u, SCALE) >> 8) + (GALAXY_WIDTH / 2);
+                    screen_y = (int16_t)(smul16x8(v, SCALE) >> 8) + (GALAXY_HEIGHT / 2);
+                }
 
                 // --- EXPLOSION CHECK ---
-                if (exp_active) {
-                    if (abs(screen_x - exp_x) < 32 && abs(screen_y - exp_y) < 32) {
-                        // Color Burst
-                        if (exp_type == 0) particle_state[i] = 1; // Blue/Cyan
-                        else particle_state[i] = 2; // Red/Gold
-                        
-                        // Perturb Simulation to create "Shockwave"
-                        // Random nudge to x/y
-                         x += (rand() & 7) - 3;
-                         y += (rand() & 7) - 3;
+                // exp_active only drops out when no blast is live (see
+                // GALAXY_REACH); the union box keeps misses to four compares.
+                if (exp_active &&
+                    screen_x >= exp_bounds.x0 && screen_x <= exp_bounds.x1 &&
+                    screen_y >= exp_bounds.y0 && screen_y <= exp_bounds.y1) {
+                    bool hit = false;
+                    // Oldest first, so the newest blast sets the color
+                    for (uint8_t b = 0; b < MAX_EXPLOSIONS; b++) {
+                        const explosion_t *e = &explosions[(exp_head + b) & (MAX_EXPLOSIONS - 1)];
+                        if (e->timer &&
+                            screen_x >= e->box.x0 && screen_x <= e->box.x1 &&
+                            screen_y >= e->box.y0 && screen_y <= e->box.y1) {
+                            // Color Burst
+                            if (e->type == 0) particle_state[i] = 1; // Blue/Cyan
+                            else particle_state[i] = 2; // Red/Gold
+                            hit = true;
+                        }
+                    }
+                    
+                    // Perturb Simulation to create "Shockwave"
+                    // One random nudge to x/y however many blasts hit
+                    if (hit) {
+                        x += exp_jitter();
+                        y += exp_jitter();
                     }
                 }
 
@@ -277,79 +734,49 @@ bool galaxy_tick(void)
                 // So yes, we check every step.
                 
                 // Check Enemies (Infect)
-                for (int e = 0; e < MAX_ENEMIES; e++) {
-                    if (enemies[e].active) {
-                        int16_t ex = (enemies[e].x >> 4) + 8; // Center
-                        int16_t ey = (enemies[e].y >> 4) + 8;
-                        
-
-                        
-                        // RADIUS 16 (Box 32x32)
-                        // User requested Enemy Box 32x32 -> Radius 16
-                        if (abs(screen_x - ex) < 16 && abs(screen_y - ey) < 16) {
-                            particle_state[i] = 1; // Infected
-                        }
+                for (uint8_t n = 0; n < enemy_live_count; n++) {
+                    uint8_t e = enemy_live[n];
+                    int16_t ex = ((enemy_x[e] >> 4) + 8) >> GALAXY_SHIFT; // Center
+                    int16_t ey = ((enemy_y[e] >> 4) + 8) >> GALAXY_SHIFT;
+                    
+                    // RADIUS 16 (Box 32x32)
+                    // User requested Enemy Box 32x32 -> Radius 16
+                    if (abs(screen_x - ex) < (16 >> GALAXY_SHIFT) && abs(screen_y - ey) < (16 >> GALAXY_SHIFT)) {
+                        particle_state[i] = 1; // Infected
                     }
                 }
                 
                 // Check Gardeners (Heal)
-                for (int w = 0; w < MAX_WORKERS; w++) {
-                    if (workers[w].active && workers[w].type == 1) { // Type 1 = Gardener
-                        int16_t wx = (workers[w].x >> 4) + 8;
-                        int16_t wy = (workers[w].y >> 4) + 8;
-                        // RADIUS 8 (Box 16x16) - Less effective
-                        if (abs(screen_x - wx) < 8 && abs(screen_y - wy) < 8) {
-                            particle_state[i] = 2; // ENRICHED (Gold)
-                        }
-                    } 
+                for (uint8_t g = 0; g < gardener_count; g++) {
+                    uint8_t w = gardener_live[g];
+                    int16_t wx = ((worker_x[w] >> 4) + 8) >> GALAXY_SHIFT;
+                    int16_t wy = ((worker_y[w] >> 4) + 8) >> GALAXY_SHIFT;
+                    // RADIUS 8 (Box 16x16) - Less effective
+                    if (abs(screen_x - wx) < (8 >> GALAXY_SHIFT) && abs(screen_y - wy) < (8 >> GALAXY_SHIFT)) {
+                        particle_state[i] = 2; // ENRICHED (Gold)
+                    }
                 }
                 
                 uint8_t state = particle_state[i];
                 
-                // Draw 3x3 Blur Patch
-                for (int dy = -1; dy <= 1; dy++) {
-                    for (int dx = -1; dx <= 1; dx++) {
-                        int16_t px = screen_x + dx;
-                        int16_t py = screen_y + dy;
-                        
-                        if (px >= 0 && px < SCREEN_WIDTH && py >= 0 && py < SCREEN_HEIGHT) {
-                            uint16_t addr = (uint16_t)px + (SCREEN_WIDTH * (uint16_t)py);
-                            
-                            // Color Logic
-                            uint8_t is_pink = (i < (N/2));
-                            
-                            if (state == 1) is_pink = 0; // Force Cyan (Infected)
-                            if (state == 2) is_pink = 1; // Force Pink (Enriched)
-                            
-                            RIA.addr0 = addr;
-                            RIA.step0 = 0; 
-                            uint8_t old_val = RIA.rw0;
-                            
-                            uint8_t pink = (old_val >> 4) & 0x0F;
-                            uint8_t cyan = old_val & 0x0F;
-                            
-                            // VISUAL POP
-                            if (state == 1) pink = 0; // Kill Pink if Infected
-                            if (state == 2) cyan = 0; // Kill Cyan if Enriched
-                            
-                            // Strong Accumulation (+6 Center, +2 Neighbor)
-                            uint8_t add_amount = (dx == 0 && dy == 0) ? 6 : 2;
-                            
-                            if (is_pink) {
-                                if (pink < (15 - add_amount)) pink += add_amount;
-                                else pink = 15;
-                            } else {
-                                if (cyan < (15 - add_amount)) cyan += add_amount;
-                                else cyan = 15;
-                            }
-                            
-                            RIA.rw0 = (pink << 4) | cyan;
-                        }
-                    }
-                }
+                // Color Logic: pick the blend pages for this particle
+                // Infected forces cyan and kills pink, Enriched forces pink
+                // and kills cyan (VISUAL POP). See BLEND_LUT in tables.h.
+                uint8_t mode = (i < (N/2)) ? BLEND_PINK : BLEND_CYAN;
+                if (state == 1) mode = BLEND_INFECTED;
+                if (state == 2) mode = BLEND_ENRICHED;
+                
+#ifdef GALAXY_ERASE_LIST
+                erase_list[erase_idx++] = splat_pixel(screen_x, screen_y, mode);
+#else
+                splat_patch(screen_x, screen_y, mode);
+#endif
                 
                  part_j++;
             }
+#ifdef GALAXY_SPLAT_COALESCE
+            splat_flush();
+#endif
             return false;
     }
     return false;
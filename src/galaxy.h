@@ -6,10 +6,30 @@ void galaxy_randomize(uint16_t seed);
 void galaxy_infect(int16_t px, int16_t py);
 void galaxy_heal(int16_t px, int16_t py);
 #include <stdbool.h>
+#include <stdint.h>
 
-void galaxy_init(void);
-void galaxy_init(void);
+// After galaxy_init the bitmap is cleared in slices by galaxy_clear_step
+// (true once done) before galaxy_tick may run. The palette is an XRAM
+// asset, loaded with the program.
+#define GALAXY_CLEAR_SLICE 8192U
+bool galaxy_clear_step(void);
 bool galaxy_tick(void); // Returns true when a full frame is completed
 void galaxy_explosion(int16_t x, int16_t y, uint8_t type);
 
+#ifdef GALAXY_SPLAT_STATS
+// Running totals for the splat coalescing buffer: blends requested by the
+// particle pass versus XRAM bytes actually written, and portal setups.
+// Counted only in GALAXY_SPLAT_STATS builds, off the timed hot path.
+typedef struct {
+    uint32_t contributions;
+    uint32_t writes;
+    uint32_t runs;
+} galaxy_splat_stats_t;
+
+extern galaxy_splat_stats_t galaxy_splat_stats;
+
+// Print the totals and contributions per write to the console.
+void galaxy_splat_report(void);
+#endif
+
 #endif // GALAXY_H
@@ -0,0 +1,45 @@
+#ifndef GALAXY_KERNEL_H
+#define GALAXY_KERNEL_H
+
+#include <stdint.h>
+#include "sprites.h" // MAX_ENEMIES, MAX_WORKERS
+
+// Assembly particle step (galaxy_kernel.s, built with USE_ASM_PARTICLES).
+// galaxy_tick fills galaxy_kernel and calls galaxy_particles_asm(count) to
+// run `count` inner-loop steps of one particle i. The C loop in galaxy.c is
+// the reference: both must write the same framebuffer bit for bit, which
+// tools/kernel_equiv.py checks on the host.
+
+// Kernel screen space: every attractor step lands on screen_x 40..280 and
+// screen_y -30..210, so both axes fit a byte once biased by these.
+#define KERNEL_X_BIAS (-40)
+#define KERNEL_Y_BIAS 30
+
+#define KERNEL_MAX_ZONES (MAX_ENEMIES + MAX_WORKERS)
+
+// Entity influence box, inclusive bounds in kernel screen space.
+// A particle landing inside gets particle_state = state; later zones win,
+// matching the enemy-then-gardener order of the C checks.
+typedef struct {
+    uint8_t x0, x1;
+    uint8_t y0, y1;
+    uint8_t state;
+} kernel_zone_t;
+
+// Field offsets are hard-coded in galaxy_kernel.s (GK_*).
+typedef struct {
+    int16_t x, y, t;       // attractor state, t read-only
+    uint8_t ri_idx;        // cached_ri_idx
+    uint8_t i_rad_idx;     // cached_i_rad_idx
+    uint8_t state;         // particle_state[i], updated by zone hits
+    uint8_t pink;          // 1 if i < N/2
+    uint8_t zone_count;
+    uint8_t lut_page;      // high byte of BLEND_LUT (page aligned)
+    kernel_zone_t zones[KERNEL_MAX_ZONES];
+} galaxy_kernel_t;
+
+extern galaxy_kernel_t galaxy_kernel;
+
+void galaxy_particles_asm(uint8_t count);
+
+#endif // GALAXY_KERNEL_H
@@ -0,0 +1,387 @@
+; galaxy_kernel.s - attractor particle step for galaxy_tick (USE_ASM_PARTICLES)
+;
+; void galaxy_particles_asm(uint8_t count)      count in A, 1..N
+;
+; Runs `count` steps of the inner j loop for one particle i: the RAD_SCALE
+; index math, the four sine reads, the x/y feedback, the entity zone tests
+; and the 3x3 read-modify-write splat. galaxy_tick sets up galaxy_kernel
+; (see galaxy_kernel.h) and copies x, y and state back afterwards.
+;
+; The C loop in galaxy.c is the reference. Every step there has
+; |u|, |v| <= 512, so screen_x is 40..280 and screen_y is -30..210. Here
+; both are kept biased into a byte (sx - 40, sy + 30, each 0..240): zone
+; tests are 8-bit compares, the column bounds test always passes and is
+; dropped, and rows come from ROW_TL_LO/HI (gen_tables.py --kernel).
+; The splat blends through BLEND_LUT (tables.h): one indexed load per
+; pixel.
+;
+; Working state lives in zero page for the batch. Clobbers A, X, Y and the
+; kernel's own zero page; the compiler's imaginary registers are untouched.
+
+.set RIA_RW0,   0xFFE4
+.set RIA_STEP0, 0xFFE5
+.set RIA_ADDR0, 0xFFE6
+.set RIA_RW1,   0xFFE8
+.set RIA_STEP1, 0xFFE9
+.set RIA_ADDR1, 0xFFEA
+
+; galaxy_kernel_t field offsets
+.set GK_X,      0
+.set GK_Y,      2
+.set GK_T,      4
+.set GK_RI,     6
+.set GK_IRAD,   7
+.set GK_STATE,  8
+.set GK_PINK,   9
+.set GK_NZONES, 10
+.set GK_LUT,    11
+.set GK_ZONES,  12
+
+.section .zp.bss.galaxy_kernel,"zaw",@nobits
+gk_x:     .zero 2       ; gk_x, gk_y, gk_t copied as one 6-byte block
+gk_y:     .zero 2
+gk_t:     .zero 2
+gk_u:     .zero 2
+gk_tmp:   .zero 2
+gk_addr:  .zero 2       ; XRAM address of the current splat row
+gk_lut_e: .zero 2       ; BLEND_LUT row for the 8 edge pixels
+gk_lut_c: .zero 2       ; BLEND_LUT row for the centre pixel
+gk_i1:    .zero 1       ; idx_u1
+gk_i2:    .zero 1       ; idx_u2
+gk_sx:    .zero 1       ; screen_x - 40
+gk_sy:    .zero 1       ; screen_y + 30
+gk_count: .zero 1
+gk_state: .zero 1
+
+.section .text.galaxy_particles_asm,"ax",@progbits
+.globl galaxy_particles_asm
+galaxy_particles_asm:
+    sta mos8(gk_count)
+    ldx #5
+.Lcopy_in:
+    lda galaxy_kernel+GK_X,x
+    sta mos8(gk_x),x
+    dex
+    bpl .Lcopy_in
+    lda galaxy_kernel+GK_STATE
+    sta mos8(gk_state)
+    lda #1
+    sta RIA_STEP0
+    sta RIA_STEP1
+    lda #0
+    sta mos8(gk_lut_e)
+    sta mos8(gk_lut_c)
+
+.Lstep:
+    ; y_idx = hi(y * 41). y * 41 = ((y * 5) << 3) + y; only bits 8..15 are
+    ; used, which the low 16 bits of the product already hold.
+    lda mos8(gk_y)
+    sta mos8(gk_tmp)
+    lda mos8(gk_y+1)
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    tax
+    clc
+    lda mos8(gk_tmp)
+    adc mos8(gk_y)
+    sta mos8(gk_tmp)
+    txa
+    adc mos8(gk_y+1)
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    tax
+    clc
+    lda mos8(gk_tmp)
+    adc mos8(gk_y)
+    txa
+    adc mos8(gk_y+1)
+    clc
+    adc galaxy_kernel+GK_IRAD
+    sta mos8(gk_i1)
+
+    ; x_idx = hi(x * 41), same sequence
+    lda mos8(gk_x)
+    sta mos8(gk_tmp)
+    lda mos8(gk_x+1)
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    tax
+    clc
+    lda mos8(gk_tmp)
+    adc mos8(gk_x)
+    sta mos8(gk_tmp)
+    txa
+    adc mos8(gk_x+1)
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    tax
+    clc
+    lda mos8(gk_tmp)
+    adc mos8(gk_x)
+    txa
+    adc mos8(gk_x+1)
+    clc
+    adc galaxy_kernel+GK_RI
+    sta mos8(gk_i2)
+
+    ; u = sin(i1) + sin(i2), v = cos(i1) + cos(i2); y = v
+    ldx mos8(gk_i1)
+    ldy mos8(gk_i2)
+    clc
+    lda SIN_LO,x
+    adc SIN_LO,y
+    sta mos8(gk_u)
+    lda SIN_HI,x
+    adc SIN_HI,y
+    sta mos8(gk_u+1)
+    clc
+    lda COS_LO,x
+    adc COS_LO,y
+    sta mos8(gk_y)
+    lda COS_HI,x
+    adc COS_HI,y
+    sta mos8(gk_y+1)
+
+    ; x = u + t
+    clc
+    lda mos8(gk_u)
+    adc mos8(gk_t)
+    sta mos8(gk_x)
+    lda mos8(gk_u+1)
+    adc mos8(gk_t+1)
+    sta mos8(gk_x+1)
+
+    ; sx = hi(u * 60) + 120. |u * 60| <= 30720 fits 16 bits, so the high
+    ; byte is the floored (u * SCALE) >> 8. u * 60 = ((u << 4) - u) << 2.
+    lda mos8(gk_u)
+    sta mos8(gk_tmp)
+    lda mos8(gk_u+1)
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    tax
+    sec
+    lda mos8(gk_tmp)
+    sbc mos8(gk_u)
+    sta mos8(gk_tmp)
+    txa
+    sbc mos8(gk_u+1)
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    clc
+    adc #120
+    sta mos8(gk_sx)
+
+    ; sy = hi(v * 60) + 120
+    lda mos8(gk_y)
+    sta mos8(gk_tmp)
+    lda mos8(gk_y+1)
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    tax
+    sec
+    lda mos8(gk_tmp)
+    sbc mos8(gk_y)
+    sta mos8(gk_tmp)
+    txa
+    sbc mos8(gk_y+1)
+    asl mos8(gk_tmp)
+    rol
+    asl mos8(gk_tmp)
+    rol
+    clc
+    adc #120
+    sta mos8(gk_sy)
+
+    ; Entity zones: x0 <= sx <= x1 && y0 <= sy <= y1 -> state
+    ldy galaxy_kernel+GK_NZONES
+    beq .Lzones_done
+    ldx #0
+.Lzone:
+    lda mos8(gk_sx)
+    cmp galaxy_kernel+GK_ZONES+0,x
+    bcc .Lzone_next
+    lda galaxy_kernel+GK_ZONES+1,x
+    cmp mos8(gk_sx)
+    bcc .Lzone_next
+    lda mos8(gk_sy)
+    cmp galaxy_kernel+GK_ZONES+2,x
+    bcc .Lzone_next
+    lda galaxy_kernel+GK_ZONES+3,x
+    cmp mos8(gk_sy)
+    bcc .Lzone_next
+    lda galaxy_kernel+GK_ZONES+4,x
+    sta mos8(gk_state)
+.Lzone_next:
+    txa
+    clc
+    adc #5
+    tax
+    dey
+    bne .Lzone
+.Lzones_done:
+
+    ; Colour: BLEND_LUT rows mode * 2 (+2 edge) and mode * 2 + 1 (+6
+    ; centre). Infected is mode 2, enriched mode 3, otherwise pink (0) for
+    ; i < N/2 and cyan (1).
+    lda mos8(gk_state)
+    ldx #4
+    cmp #1
+    beq 1f
+    ldx #6
+    cmp #2
+    beq 1f
+    ldx #0
+    lda galaxy_kernel+GK_PINK
+    bne 1f
+    ldx #2
+1:
+    txa
+    clc
+    adc galaxy_kernel+GK_LUT
+    sta mos8(gk_lut_e+1)
+    adc #1
+    sta mos8(gk_lut_c+1)
+
+    ; Top-left pixel of the 3x3 patch
+    ldx mos8(gk_sy)
+    clc
+    lda ROW_TL_LO,x
+    adc mos8(gk_sx)
+    sta mos8(gk_addr)
+    lda ROW_TL_HI,x
+    adc #0
+    sta mos8(gk_addr+1)
+
+    ; Three rows, each on screen when 0 <= row - 30 < SCREEN_HEIGHT (row
+    ; biased like gk_sy). Each streams in through portal 0 and back out
+    ; through portal 1.
+    ; row sy - 1
+    lda mos8(gk_sy)
+    sec
+    sbc #31
+    cmp #180
+    bcs 2f
+    lda mos8(gk_addr)
+    sta RIA_ADDR0
+    sta RIA_ADDR1
+    lda mos8(gk_addr+1)
+    sta RIA_ADDR0+1
+    sta RIA_ADDR1+1
+    lda RIA_RW0
+    tay
+    lda (mos8(gk_lut_e)),y
+    sta RIA_RW1
+    lda RIA_RW0
+    tay
+    lda (mos8(gk_lut_e)),y
+    sta RIA_RW1
+    lda RIA_RW0
+    tay
+    lda (mos8(gk_lut_e)),y
+    sta RIA_RW1
+2:
+    clc
+    lda mos8(gk_addr)
+    adc #(320 & 0xFF)
+    sta mos8(gk_addr)
+    lda mos8(gk_addr+1)
+    adc #(320 >> 8)
+    sta mos8(gk_addr+1)
+    ; row sy, centre pixel +6
+    lda mos8(gk_sy)
+    sec
+    sbc #30
+    cmp #180
+    bcs 3f
+    lda mos8(gk_addr)
+    sta RIA_ADDR0
+    sta RIA_ADDR1
+    lda mos8(gk_addr+1)
+    sta RIA_ADDR0+1
+    sta RIA_ADDR1+1
+    lda RIA_RW0
+    tay
+    lda (mos8(gk_lut_e)),y
+    sta RIA_RW1
+    lda RIA_RW0
+    tay
+    lda (mos8(gk_lut_c)),y
+    sta RIA_RW1
+    lda RIA_RW0
+    tay
+    lda (mos8(gk_lut_e)),y
+    sta RIA_RW1
+3:
+    clc
+    lda mos8(gk_addr)
+    adc #(320 & 0xFF)
+    sta mos8(gk_addr)
+    lda mos8(gk_addr+1)
+    adc #(320 >> 8)
+    sta mos8(gk_addr+1)
+    ; row sy + 1
+    lda mos8(gk_sy)
+    sec
+    sbc #29
+    cmp #180
+    bcs 4f
+    lda mos8(gk_addr)
+    sta RIA_ADDR0
+    sta RIA_ADDR1
+    lda mos8(gk_addr+1)
+    sta RIA_ADDR0+1
+    sta RIA_ADDR1+1
+    lda RIA_RW0
+    tay
+    lda (mos8(gk_lut_e)),y
+    sta RIA_RW1
+    lda RIA_RW0
+    tay
+    lda (mos8(gk_lut_e)),y
+    sta RIA_RW1
+    lda RIA_RW0
+    tay
+    lda (mos8(gk_lut_e)),y
+    sta RIA_RW1
+4:
+
+    dec mos8(gk_count)
+    beq .Ldone
+    jmp .Lstep
+
+.Ldone:
+    ldx #3
+.Lcopy_out:
+    lda mos8(gk_x),x
+    sta galaxy_kernel+GK_X,x
+    dex
+    bpl .Lcopy_out
+    lda mos8(gk_state)
+    sta galaxy_kernel+GK_STATE
+    rts
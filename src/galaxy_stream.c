@@ -0,0 +1,110 @@
+#include <rp6502.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "galaxy_stream.h"
+
+#define STREAM_N GALAXY_STREAM_N
+#define STREAM_HALF 512
+#define STREAM_SLICE_BYTES (GALAXY_STREAM_SLICE * 2)
+
+typedef struct {
+    char magic[2];   // "GS"
+    uint8_t n;
+    uint8_t shift;   // 1 = GALAXY_HALF_RES coordinates
+    uint16_t frames;
+} stream_header_t;
+
+_Static_assert(STREAM_HALF % STREAM_SLICE_BYTES == 0, "slices straddle halves");
+_Static_assert((2 * STREAM_N * STREAM_N) % STREAM_HALF == 0, "frames are not whole halves");
+
+static int stream_fd = -1;
+static uint8_t stream_buffer[2 * STREAM_HALF];
+static uint16_t stream_idx = 0;         // Next slice, 0..2 * STREAM_HALF
+static uint8_t stream_half_ready = 0;   // Bit per half holding unplayed data
+static uint8_t stream_fill_next = 0;    // Half the next read goes into
+
+static void stream_close(void) {
+    close(stream_fd);
+    stream_fd = -1;
+}
+
+static void stream_read_half(uint8_t half) {
+    int res = read(stream_fd, &stream_buffer[half * STREAM_HALF], STREAM_HALF);
+
+    // Frames are whole halves, so the end of the file falls between two:
+    // start over after the header
+    if (res == 0 && lseek(stream_fd, sizeof(stream_header_t), SEEK_SET) >= 0) {
+        res = read(stream_fd, &stream_buffer[half * STREAM_HALF], STREAM_HALF);
+    }
+    if (res != STREAM_HALF) {
+        printf("Stream: Read Error %d\n", res < 0 ? errno : res);
+        stream_close();
+        return;
+    }
+
+    stream_half_ready |= 1 << half;
+    stream_fill_next = half ^ 1;
+}
+
+bool galaxy_stream_open(const char *filename) {
+    stream_header_t h;
+
+    stream_fd = open(filename, O_RDONLY);
+    if (stream_fd < 0) {
+        printf("Stream: Failed to open %s\n", filename);
+        return false;
+    }
+
+#ifdef GALAXY_HALF_RES
+    const uint8_t shift = 1;
+#else
+    const uint8_t shift = 0;
+#endif
+    if (read(stream_fd, &h, sizeof(h)) != sizeof(h) || h.magic[0] != 'G' || h.magic[1] != 'S' ||
+        h.n != STREAM_N || h.shift != shift || h.frames == 0) {
+        printf("Stream: %s does not match this build\n", filename);
+        stream_close();
+        return false;
+    }
+
+    stream_idx = 0;
+    stream_half_ready = 0;
+    stream_read_half(0);
+    if (stream_fd >= 0) stream_read_half(1);
+    if (stream_fd < 0) return false;
+
+    printf("Stream: %u frames\n", h.frames);
+    return true;
+}
+
+// Fill both halves if the galaxy has freed them: a fast galaxy can drain
+// more than one half between vsyncs
+void galaxy_stream_refill(void) {
+    while (stream_fd >= 0 && !(stream_half_ready & (1 << stream_fill_next))) {
+        stream_read_half(stream_fill_next);
+    }
+}
+
+const uint8_t *galaxy_stream_slice(void) {
+    if (stream_fd < 0) return NULL;
+
+    uint8_t half = stream_idx / STREAM_HALF;
+    if (!(stream_half_ready & (1 << half))) {
+        // Read-ahead fell behind: read it now
+        stream_read_half(half);
+        if (stream_fd < 0) return NULL;
+    }
+
+    const uint8_t *p = &stream_buffer[stream_idx];
+    stream_idx += STREAM_SLICE_BYTES;
+
+    // Finished a half: hand it back to the read-ahead
+    if ((stream_idx & (STREAM_HALF - 1)) == 0) {
+        stream_half_ready &= ~(1 << half);
+        stream_idx &= 2 * STREAM_HALF - 1;
+    }
+    return p;
+}
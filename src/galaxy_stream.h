@@ -0,0 +1,39 @@
+#ifndef GALAXY_STREAM_H
+#define GALAXY_STREAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Precomputed galaxy stream (GALAXY_STREAM builds)
+ * tools/gen_galaxy_stream.py runs the attractor ahead of time and stores
+ * every step's splat position, two bytes a step. galaxy_tick then skips
+ * the fixed-point math and only splats, tinting each particle by its
+ * live infection / heal / blast state as before. Blasts still recolour
+ * particles but no longer jitter the orbit.
+ *
+ * The file is read through two 512-byte halves, like the music:
+ * galaxy_stream_refill (a periodic task) fills whichever half is free,
+ * galaxy_stream_slice hands out one slice at a time and reads a half
+ * itself only if the read-ahead fell behind. The file loops at its end;
+ * the default 322 frames are one turn of t, so the loop seam moves the
+ * particles no further than a normal frame (see gen_galaxy_stream.py).
+ */
+
+#define GALAXY_STREAM_FILENAME "ROM:GALAXY.GS"
+#define GALAXY_STREAM_N 80    // Particle grid, N in galaxy.c
+#define GALAXY_STREAM_SLICE 8 // Steps per galaxy_tick slice, 2 bytes each
+
+// Open the stream and fill both halves. False (with a message) if the
+// file is missing or was made for another N or resolution; galaxy_tick
+// then computes the attractor live.
+bool galaxy_stream_open(const char *filename);
+
+// Read-ahead task. Cheap when both halves are full.
+void galaxy_stream_refill(void);
+
+// Position bytes (x, y, x, y, ...) for the next GALAXY_STREAM_SLICE steps,
+// or NULL when the stream is not open. Valid until the next call.
+const uint8_t *galaxy_stream_slice(void);
+
+#endif // GALAXY_STREAM_H
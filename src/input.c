@@ -19,6 +19,10 @@ gamepad_t gamepad[GAMEPAD_COUNT];
 uint8_t keystates[KEYBOARD_BYTES] = {0};
 bool handled_key = false;
 
+// Action snapshot (see input.h)
+action_state_t actions[GAMEPAD_COUNT];
+_Static_assert(ACTION_COUNT <= 8, "action_state_t fields are one byte");
+
 // Helper for checking if any input is pressed
 bool is_any_input_pressed(void) {
     if (is_action_pressed(0, ACTION_FIRE)) return true;
@@ -144,7 +148,32 @@ void init_input_system(void)
 }
 
 /**
- * Read keyboard and gamepad input
+ * Actions held by a player this frame, from the keyboard (player 0 only
+ * for now) and, if connected, their gamepad
+ */
+static uint8_t read_actions(uint8_t player_id)
+{
+    uint8_t held = 0;
+    bool connected = (gamepad[player_id].dpad & GP_CONNECTED) != 0;
+    // dpad, sticks, btn0, btn1 are the first four bytes of gamepad_t,
+    // in GP_FIELD_* order
+    const uint8_t *fields = &gamepad[player_id].dpad;
+
+    for (uint8_t action = 0; action < ACTION_COUNT; action++) {
+        ButtonMapping* mapping = &button_mappings[player_id][action];
+
+        if (player_id == 0 && key(mapping->keyboard_key)) {
+            held |= ACTION_BIT(action);
+        } else if (connected && mapping->gamepad_button <= GP_FIELD_BTN1 &&
+                   (fields[mapping->gamepad_button] & mapping->gamepad_mask)) {
+            held |= ACTION_BIT(action);
+        }
+    }
+    return held;
+}
+
+/**
+ * Read keyboard and gamepad input, then update the action snapshot
  */
 void handle_input(void)
 {
@@ -155,11 +184,24 @@ void handle_input(void)
         keystates[i] = RIA.rw0;
     }
     
-    // Read gamepad data
-    RIA.addr0 = GAMEPAD_INPUT;
-    RIA.step0 = 1;
+    // Read gamepad data. The status byte comes first; a pad without
+    // GP_CONNECTED is zeroed and the rest of its 10 bytes skipped.
     for (uint8_t i = 0; i < GAMEPAD_COUNT; i++) {
+        RIA.addr0 = GAMEPAD_INPUT + i * sizeof(gamepad_t);
+        RIA.step0 = 1;
         gamepad[i].dpad = RIA.rw0;
+        if (!(gamepad[i].dpad & GP_CONNECTED)) {
+            gamepad[i].sticks = 0;
+            gamepad[i].btn0 = 0;
+            gamepad[i].btn1 = 0;
+            gamepad[i].lx = 0;
+            gamepad[i].ly = 0;
+            gamepad[i].rx = 0;
+            gamepad[i].ry = 0;
+            gamepad[i].l2 = 0;
+            gamepad[i].r2 = 0;
+            continue;
+        }
         gamepad[i].sticks = RIA.rw0;
         gamepad[i].btn0 = RIA.rw0;
         gamepad[i].btn1 = RIA.rw0;
@@ -170,11 +212,20 @@ void handle_input(void)
         gamepad[i].l2 = RIA.rw0;
         gamepad[i].r2 = RIA.rw0;
     }
-    
+
+    // Edges against last frame's snapshot
+    for (uint8_t i = 0; i < GAMEPAD_COUNT; i++) {
+        uint8_t held = read_actions(i);
+        uint8_t was = actions[i].held;
+        actions[i].held = held;
+        actions[i].pressed = held & ~was;
+        actions[i].released = was & ~held;
+    }
 }
 
 /**
- * Check if a game action is active for a specific player
+ * Check if a game action is held for a specific player (this frame's
+ * snapshot)
  */
 bool is_action_pressed(uint8_t player_id, GameAction action)
 {
@@ -182,28 +233,5 @@ bool is_action_pressed(uint8_t player_id, GameAction action)
         return false;
     }
     
-    ButtonMapping* mapping = &button_mappings[player_id][action];
-    
-    // Check keyboard (player 0 only for now)
-    if (player_id == 0) {
-        if (key(mapping->keyboard_key)) {
-            return true;
-        }
-    }
-    
-    // Only check gamepad if one is connected
-    if (!(gamepad[player_id].dpad & GP_CONNECTED)) {
-        return false;
-    }
-    
-    // Check gamepad
-    uint8_t gamepad_value = 0;
-    switch (mapping->gamepad_button) {
-        case 0: gamepad_value = gamepad[player_id].dpad; break;
-        case 1: gamepad_value = gamepad[player_id].sticks; break;
-        case 2: gamepad_value = gamepad[player_id].btn0; break;
-        case 3: gamepad_value = gamepad[player_id].btn1; break;
-    }
-    
-    return (gamepad_value & mapping->gamepad_mask) != 0;
+    return (actions[player_id].held & ACTION_BIT(action)) != 0;
 }
@@ -69,6 +69,16 @@ typedef enum {
     ACTION_COUNT  // Total number of actions
 } GameAction;
 
+// Per-frame action snapshot, one per player, built by handle_input once
+// per vsync. Each field has bit (1 << action) per GameAction.
+#define ACTION_BIT(action) (1 << (action))
+
+typedef struct {
+    uint8_t held;      // Down this frame
+    uint8_t pressed;   // Down this frame, up last frame
+    uint8_t released;  // Up this frame, down last frame
+} action_state_t;
+
 // Gamepad structure (10 bytes per gamepad)
 typedef struct {
     uint8_t dpad;      // Direction pad + status bits
@@ -101,5 +111,6 @@ extern void handle_input(void);
 extern bool is_action_pressed(uint8_t player_id, GameAction action);
 extern bool is_any_input_pressed(void);
 extern gamepad_t gamepad[GAMEPAD_COUNT]; // Exposed for analog access
+extern action_state_t actions[GAMEPAD_COUNT];
 
 #endif // INPUT_H
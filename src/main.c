@@ -2,12 +2,24 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <stdio.h>
 #include "constants.h"
 #include "opl.h"
 #include "instruments.h"
 #include "galaxy.h"
 #include "sprites.h"
+#include "sprite_mux.h"
 #include "input.h"
+#include "sched.h"
+#ifdef MEM_PROBE
+#include "mem_probe.h"
+#endif
+#ifdef PACKED_ASSETS
+#include "asset.h"
+#endif
+#ifdef GALAXY_STREAM
+#include "galaxy_stream.h"
+#endif
 #include "usb_hid_keys.h"
 
 #define SONG_HZ 60
@@ -21,7 +33,7 @@ static void init_graphics(void)
     // Initialize graphics here
     xregn(1, 0, 0, 1, 2); // 320x180
 
-    // Note: galaxy_init handles palette and clearing now
+    // Note: the palette is an XRAM asset, the boot task clears the bitmap
     
     // Configure bitmap parameters
     xram0_struct_set(BITMAP_CONFIG_ADDR, vga_mode3_config_t, x_pos_px, 0);
@@ -30,27 +42,14 @@ static void init_graphics(void)
     xram0_struct_set(BITMAP_CONFIG_ADDR, vga_mode3_config_t, height_px, 180);
     xram0_struct_set(BITMAP_CONFIG_ADDR, vga_mode3_config_t, xram_data_ptr, 0);
     xram0_struct_set(BITMAP_CONFIG_ADDR, vga_mode3_config_t, xram_palette_ptr, PALETTE_ADDR); // Use custom palette
-    
-    // Enable Mode 3 bitmap (8-bit color)
-    xregn(1, 0, 1, 4, 3, 3, BITMAP_CONFIG_ADDR, 0);
 }
 
-void init_all_systems(void) {
-    // Hardware Setup - Input
-    xregn(0, 0, 0, 1, KEYBOARD_INPUT);
-    xregn(0, 0, 2, 1, GAMEPAD_INPUT);
-
-    init_graphics();
-
-    // Audio Setup
-    OPL_Config(1, OPL_ADDR);
-    opl_init();
-    music_init(MUSIC_FILENAME);
-    
-    // Galaxy Setup
-    galaxy_init();
-    init_input_system();
-    init_sprites();
+// Enable Mode 3 bitmap (8-bit color, or 4-bit with GALAXY_4BPP) on plane 0.
+// Only once the bitmap is cleared: until then XRAM 0x0000 holds whatever
+// boot left there (the LZ scratch with PACKED_ASSETS).
+static void show_bitmap(void)
+{
+    xregn(1, 0, 1, 4, 3, BITMAP_MODE3_ATTR, BITMAP_CONFIG_ADDR, 0);
 }
 
 void process_audio_frame(void) {
@@ -63,101 +62,225 @@ void process_audio_frame(void) {
     }
 }
 
-int main(void)
-{
-    init_all_systems();
+static void sprites_run(void) {
+    update_sprites();
+    update_enemies();
+    update_workers();
+}
+
+// Set by boot_sprites. Input is polled from the first frame, so ESC
+// works during boot; spawning and the reticle wait for the sprites.
+static bool sprites_ready = false;
+
+static void input_run(void) {
+    handle_input();
+    if (key(KEY_ESC)) {
+        sched_report();
+#ifdef GALAXY_SPLAT_STATS
+        galaxy_splat_report();
+#endif
+#ifdef MEM_PROBE
+        mem_probe_report();
+#endif
+        exit(0);
+    }
+    if (!sprites_ready) return;
 
-    uint8_t vsync_last = RIA.vsync;
-    int frame_count = 0;
+    // Worker Spawning: one per press
+    uint8_t pressed = actions[0].pressed;
+    uint8_t held = actions[0].held;
+
+    // Fire (A / Space): Guardian
+    if (pressed & ACTION_BIT(ACTION_FIRE)) {
+        spawn_worker(0, reticle_x, reticle_y);
+    }
+    // Seed (B / V): Gardener
+    if (pressed & ACTION_BIT(ACTION_SEED)) {
+        spawn_worker(1, reticle_x, reticle_y);
+    }
     
-    // Seed Galaxy with somewhat random value (VSYNC + XRAM Data)
-    // We don't have user input yet, but VSYNC counter is running.
-    // Better: Run a small loop waiting for VSYNC to change? No.
-    // Let's use RIA.rw0 from uninitialized memory or just the frame_count after a few loops?
-    // Actually, let's just use a static counter that increments during system init?
-    // Or better: Use the first user input to re-seed?
-    // User wants "Random each start". 
-    // On real hardware, RAM might be random? No, XRAM is cleared.
-    // Let's rely on the fact that VSYNC aligns differently on boot?
-    // Or just use a hardcoded value + RIA.errno?
-    // Let's try to use the timer accumulator which might be somewhat random if OPL is ready?
-    // Actually, on RP6502, RIA.time isn't available.
-    // Let's increment a seed in the main loop until the user presses a button?
-    // But the game starts immediately.
-    // Let's just use a simple seed for now based on a loop counter.
+    int8_t dx = 0;
+    int8_t dy = 0;
+    // Digital Controls
+    if (held & ACTION_BIT(ACTION_LEFT)) dx -= 2;
+    if (held & ACTION_BIT(ACTION_RIGHT)) dx += 2;
+    if (held & ACTION_BIT(ACTION_UP)) dy -= 2;
+    if (held & ACTION_BIT(ACTION_DOWN)) dy += 2;
     
-    // Initialize with a arbitrary seed for now, but we need entropy.
-    // Let's make the Title Screen wait for "Start"?
-    // The user didn't ask for a Title Screen.
-    // I'll leave it deterministic for now but call the function so I can hook it up later?
-    // User requested randomization.
-    // I'll try to read a register that might be noisy?
-    // No.
-    // I'll use a hardcoded seed + loop iteration count.
+    // START (Pause / Enter) Reset
+    if (pressed & ACTION_BIT(ACTION_PAUSE)) {
+        reset_sprites();
+    }
     
-    galaxy_randomize(12345 + (uint16_t)&frame_count); // Stack address might vary? Unlikely.
-    // Wait, RIA.vsync is free running.
+    // Analog Controls
+    if (dx == 0 && dy == 0) {
+        if (abs(gamepad[0].lx) > 10) dx = gamepad[0].lx / 16;
+        if (abs(gamepad[0].ly) > 10) dy = gamepad[0].ly / 16;
+    }
+
+    update_reticle_position(dx, dy);
+}
+
+static void galaxy_run(void) {
+    galaxy_tick();
+}
+
+// Main loop tasks: name, run, priority, period, budget.
+// Frame work runs in priority order on each vsync, audio first so the
+// music never drifts; the galaxy fills the rest of the frame in batches
+// of slices.
+static sched_task_t audio_task        = { "audio",   process_audio_frame, 0, 1, 0 };
+static sched_task_t sprites_task      = { "sprites", sprites_run,         1, 1, 0 };
+static sched_task_t commit_task       = { "commit",  sprite_mux_commit,   2, 1, 0 };
+static sched_task_t input_task        = { "input",   input_run,           3, 1, 0 };
+static sched_task_t music_task        = { "music",   music_refill_buffer, 4, 1, 0 };
+#ifdef GALAXY_STREAM
+static sched_task_t stream_task       = { "stream",  galaxy_stream_refill, 5, 1, 0 };
+#endif
+static sched_task_t galaxy_task       = { "galaxy",  galaxy_run,          6, 0, 4 };
+
+// Boot: each step brings up one subsystem and registers the tasks that
+// depend on it, so the first frames are never blocked on the whole init.
+// Steps run back to back while the frame lasts; a step returning false
+// (the OPL wipe, the bitmap clear) resumes on the next vsync.
+static bool boot_audio(void) {
+    OPL_Config(1, OPL_ADDR);
+    opl_init_step(); // First chunk keys off every voice: quiet from here on
+    return true;
+}
+
+// The rest of the OPL register wipe, a chunk per vsync, then the audio
+// task that plays through it
+static bool boot_opl(void) {
+    if (!opl_init_step()) return false;
+    sched_add(&audio_task);
+    return true;
+}
+
+#ifdef PACKED_ASSETS
+// Sprite art from the ROM's LZ files (tools/lz_pack.py). Runs before the
+// bitmap clear, as it unpacks through the bitmap.
+static const struct {
+    const char *filename;
+    uint16_t addr;
+    uint16_t size;
+} packed_assets[] = {
+    { "ROM:RETICLE.LZ", XRAM_RETICLE_ART_ADDR, XRAM_RETICLE_ART_SIZE },
+    { "ROM:ENEMY.LZ",   XRAM_ENEMY_ART_ADDR,   XRAM_ENEMY_ART_SIZE },
+    { "ROM:WORKER.LZ",  XRAM_WORKER_ART_ADDR,  XRAM_WORKER_ART_SIZE },
+};
+
+#ifdef INDEXED_SPRITES
+#define ASSET_UNPACK asset_unpack_indexed
+#else
+#define ASSET_UNPACK asset_unpack
+#endif
+
+static bool boot_assets(void) {
+    for (uint8_t i = 0; i < sizeof(packed_assets) / sizeof(packed_assets[0]); i++) {
+        ASSET_UNPACK(packed_assets[i].filename, packed_assets[i].addr, packed_assets[i].size);
+    }
+    return true;
+}
+#endif
+
+static bool boot_video(void) {
+    init_graphics();
+    galaxy_init();
+    return true;
+}
+
+static bool boot_sprites(void) {
+    init_sprites(); // After init_graphics: the canvas resets the planes
+    sched_add(&sprites_task);
+    sched_add(&commit_task);
+    sprites_ready = true;
+    return true;
+}
+
+static bool boot_input(void) {
+    xregn(0, 0, 0, 1, KEYBOARD_INPUT);
+    xregn(0, 0, 2, 1, GAMEPAD_INPUT);
+    init_input_system(); // JOYSTICK.DAT
+    sched_add(&input_task);
+    return true;
+}
+
+static bool boot_music(void) {
+    music_init(MUSIC_FILENAME);
+    sched_add(&music_task);
+    return true;
+}
+
+#ifdef GALAXY_STREAM
+// Precomputed attractor (galaxy_stream.h). Without the file the galaxy
+// falls back to computing it live.
+static bool boot_stream(void) {
+    if (galaxy_stream_open(GALAXY_STREAM_FILENAME)) sched_add(&stream_task);
+    return true;
+}
+#endif
+
+static bool boot_galaxy(void) {
+    if (!galaxy_clear_step()) return false;
+    show_bitmap();
+
+    // Seed from the free-running vsync counter: boot timing varies a little
     galaxy_randomize(RIA.vsync * 123 + 456);
+    sched_add(&galaxy_task);
+    return true;
+}
+
+typedef struct {
+    const char *name;
+    bool (*step)(void);
+} boot_step_t;
+
+static const boot_step_t boot_steps[] = {
+    { "audio",   boot_audio },
+    { "input",   boot_input },
+#ifdef PACKED_ASSETS
+    { "assets",  boot_assets },
+#endif
+    { "video",   boot_video },
+    { "sprites", boot_sprites },
+    { "opl",     boot_opl },
+    { "music",   boot_music },
+#ifdef GALAXY_STREAM
+    { "stream",  boot_stream },
+#endif
+    { "galaxy",  boot_galaxy },
+};
+#define BOOT_STEPS (sizeof(boot_steps) / sizeof(boot_steps[0]))
 
-    while (1) {
-        // 1. Poll Audio (High Priority)
-        // Check VSYNC and update music if needed
-        uint8_t vsync_now = RIA.vsync;
-        if (vsync_now != vsync_last) {
-            vsync_last = vsync_now;
-            process_audio_frame();
-            update_sprites();
-            update_enemies();
-            update_workers();
-            
-            // Input Processing
-            handle_input();
-            if (key(KEY_ESC)) exit(0);
-
-            // Worker Spawning (Simple Cooldown)
-            static int spawn_cooldown = 0;
-            if (spawn_cooldown > 0) spawn_cooldown--;
-
-            // Button A (Guardian) - GP_BTN_A is in btn0
-            if (spawn_cooldown == 0 && (gamepad[0].btn0 & GP_BTN_A)) {
-                spawn_worker(0, reticle_x, reticle_y);
-                spawn_cooldown = 15; // 0.25s cooldown
-            }
-            // Button B (Gardener) - GP_BTN_B is in btn0
-            if (spawn_cooldown == 0 && (gamepad[0].btn0 & GP_BTN_B)) {
-                spawn_worker(1, reticle_x, reticle_y);
-                spawn_cooldown = 15;
-            }
-            
-            int8_t dx = 0;
-            int8_t dy = 0;
-            // Digital Controls
-            if (is_action_pressed(0, ACTION_LEFT)) dx -= 2;
-            if (is_action_pressed(0, ACTION_RIGHT)) dx += 2;
-            if (is_action_pressed(0, ACTION_UP)) dy -= 2;
-            if (is_action_pressed(0, ACTION_DOWN)) dy += 2;
-            
-            // START Button Reset
-            if (spawn_cooldown == 0 && (gamepad[0].btn0 & GP_BTN_START)) {
-                reset_sprites();
-                spawn_cooldown = 30; // 0.5s cooldown
-            }
-            
-            // Analog Controls
-            if (dx == 0 && dy == 0) {
-                if (abs(gamepad[0].lx) > 10) dx = gamepad[0].lx / 16;
-                if (abs(gamepad[0].ly) > 10) dy = gamepad[0].ly / 16;
-            }
-
-            update_reticle_position(dx, dy);
-
-            frame_count++;
+static uint8_t boot_idx = 0;
+static uint8_t boot_vsync; // RIA.vsync when main started
+
+static void boot_run(void);
+static sched_task_t boot_task = { "boot", boot_run, 0, 1, 0 };
+
+static void boot_run(void) {
+    uint8_t frame = RIA.vsync;
+
+    while (RIA.vsync == frame) {
+        const boot_step_t *b = &boot_steps[boot_idx];
+        if (!b->step()) return;
+
+        // Boot trace: step done, vsyncs since main
+        printf("boot: %-7s +%u vsync\n", b->name, (uint8_t)(RIA.vsync - boot_vsync));
+        if (++boot_idx == BOOT_STEPS) {
+            sched_stop(&boot_task);
+            return;
         }
-        
-        // 2. Poll Simulation (Low Priority)
-        // Run one small slice of the simulation
-        galaxy_tick();
     }
 }
 
-
+int main(void)
+{
+#ifdef MEM_PROBE
+    mem_probe_init(); // Before anything else runs deep
+#endif
+    boot_vsync = RIA.vsync;
+    sched_add(&boot_task);
+    sched_run();
+}
@@ -0,0 +1,54 @@
+#include <stdint.h>
+#include <stdio.h>
+
+#include "mem_probe.h"
+
+#define PAINT 0xA5
+#define SOFT_MARGIN 32 // Left unpainted below the soft stack pointer
+#define HW_MARGIN 8    // Same for the hardware stack
+
+// llvm-mos: end of static data (linker script) and the soft stack
+// pointer, kept in the imaginary registers rc0/rc1
+extern char __heap_start;
+extern uint8_t __rc0, __rc1;
+
+#define HW_STACK ((uint8_t *)0x100)
+
+static uint8_t *soft_top; // Soft stack pointer at init
+static uint8_t hw_top;    // S at init
+
+void mem_probe_init(void)
+{
+    soft_top = (uint8_t *)(uintptr_t)(__rc0 | ((uint16_t)__rc1 << 8));
+    for (uint8_t *p = (uint8_t *)&__heap_start; p < soft_top - SOFT_MARGIN; p++) {
+        *p = PAINT;
+    }
+
+    // Page 1 below S is free; S itself is the next push
+    uint8_t s;
+    __asm__ volatile("tsx" : "=x"(s));
+    hw_top = s;
+    for (uint8_t i = 0; i < (uint8_t)(s - HW_MARGIN); i++) {
+        HW_STACK[i] = PAINT;
+    }
+}
+
+void mem_probe_read(mem_probe_t *out)
+{
+    uint8_t *p = (uint8_t *)&__heap_start;
+    while (p < soft_top && *p == PAINT) p++;
+    out->soft_free = (uint16_t)(p - (uint8_t *)&__heap_start);
+    out->soft_peak = (uint16_t)(soft_top - p);
+
+    uint8_t i = 0;
+    while (i < hw_top && HW_STACK[i] == PAINT) i++;
+    out->hw_peak = 256 - i; // 0x100 + i up to 0x1FF
+}
+
+void mem_probe_report(void)
+{
+    mem_probe_t m;
+    mem_probe_read(&m);
+    printf("stack: soft peak %u (free %u), hardware peak %u/256\n",
+           m.soft_peak, m.soft_free, m.hw_peak);
+}
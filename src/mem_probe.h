@@ -0,0 +1,30 @@
+#ifndef MEM_PROBE_H
+#define MEM_PROBE_H
+
+#include <stdint.h>
+
+/*
+ * Stack high-water probe (MEM_PROBE builds)
+ * mem_probe_init paints the free RAM below the soft stack (down to the end
+ * of static data) and the free part of the hardware stack page with a
+ * pattern. Whatever the program later pushes overwrites it, so the lowest
+ * overwritten byte is the peak depth, however briefly it was reached.
+ * Call init first thing in main; painting ~40 KB costs a couple of frames.
+ */
+
+typedef struct {
+    uint16_t soft_peak; // Deepest soft stack use below main, bytes
+    uint16_t soft_free; // Painted bytes never touched
+    uint16_t hw_peak;   // Deepest hardware stack use, bytes of page 1
+} mem_probe_t;
+
+void mem_probe_init(void);
+
+// Scan for the high-water marks. Walks the untouched paint, so it is slow
+// (~10 cycles a byte): call it on exit or from a rare telemetry task.
+void mem_probe_read(mem_probe_t *out);
+
+// Print the marks to the console.
+void mem_probe_report(void);
+
+#endif // MEM_PROBE_H
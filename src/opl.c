@@ -5,6 +5,7 @@
 #include "opl.h"
 #include "instruments.h"
 #include "constants.h"
+#include "xram.h"
 
 #include <errno.h>
 
@@ -45,6 +46,9 @@ uint16_t midi_to_opl_freq(uint8_t midi_note) {
 }
 
 void opl_write(uint8_t reg, uint8_t data) {
+    // Borrow portal 1 from whatever stream owns it
+    xram_portal_t saved;
+    xram_portal1_save(&saved);
 #ifdef USE_NATIVE_OPL2
     RIA.addr1 = OPL_ADDR + reg;
     RIA.rw1 = data;
@@ -54,6 +58,7 @@ void opl_write(uint8_t reg, uint8_t data) {
     RIA.rw1 = reg;
     RIA.rw1 = data;
 #endif
+    xram_portal1_restore(&saved);
 }
 
 void opl_silence_all() {
@@ -65,9 +70,12 @@ void opl_silence_all() {
 }
 
 void opl_fifo_clear() {
+    xram_portal_t saved;
+    xram_portal1_save(&saved);
     RIA.addr1 = OPL_ADDR + 2; // Our new FIFO flush register
     RIA.step1 = 0;
     RIA.rw1 = 1;         // Trigger flush
+    xram_portal1_restore(&saved);
 }
 
 void OPL_NoteOn(uint8_t channel, uint8_t midi_note) {
@@ -112,29 +120,44 @@ void OPL_SetVolume(uint8_t chan, uint8_t velocity) {
     opl_write(0x40 + car_offsets[chan], (shadow_ksl_c[chan] & 0xC0) | vol);
 }
 
-void opl_init() {
-    // 1. Silence all 9 channels immediately (Key-Off)
-    // Register 0xB0-0xB8 controls Key-On
-    for (uint8_t i = 0; i < 9; i++) {
-        opl_write(0xB0 + i, 0x00);
-        shadow_b0[i] = 0;
+// opl_init in chunks of at most OPL_INIT_CHUNK register writes, so boot
+// can spread the ~250 writes over several vsyncs
+#define OPL_INIT_CHUNK 64
+static uint16_t opl_init_reg = 0; // Next register to wipe, 0 = key-off first
+
+bool opl_init_step() {
+    if (opl_init_reg == 0) {
+        // 1. Silence all 9 channels immediately (Key-Off)
+        // Register 0xB0-0xB8 controls Key-On
+        for (uint8_t i = 0; i < 9; i++) {
+            opl_write(0xB0 + i, 0x00);
+            shadow_b0[i] = 0;
+            channel_is_drum[i] = 0;
+        }
+        opl_init_reg = 0x01;
+        return false;
     }
 
     // 2. Wipe every OPL2 hardware register (0x01 to 0xF5)
     // This ensures that leftovers from a previous program 
     // (like long Release times or weird Waveforms) are gone.
-    for (int i = 0x01; i <= 0xF5; i++) {
+    uint16_t end = opl_init_reg + OPL_INIT_CHUNK;
+    if (end > 0xF6) end = 0xF6;
+    for (uint16_t i = opl_init_reg; i < end; i++) {
         opl_write(i, 0x00);
     }
-
-    for (int i = 0; i < 9; i++) {
-        channel_is_drum[i] = 0;
-        shadow_b0[i] = 0;
-    }
+    opl_init_reg = end;
+    if (end < 0xF6) return false;
 
     // 3. Re-enable the features we need
     opl_write(0x01, 0x20); // Enable Waveform Select
     opl_write(0xBD, 0x00); // Ensure Melodic Mode
+    opl_init_reg = 0;      // A later init starts over
+    return true;
+}
+
+void opl_init() {
+    while (!opl_init_step()) {}
 }
 
 void opl_silence() {
@@ -150,9 +173,12 @@ uint16_t wait_ticks = 0;
 
 void opl_fifo_flush() {
     // Ensure the Magic Key (0xAA) matches our Verilog flush logic
+    xram_portal_t saved;
+    xram_portal1_save(&saved);
     RIA.addr1 = OPL_ADDR + 2;
     RIA.step1 = 0;
     RIA.rw1 = 0xAA; 
+    xram_portal1_restore(&saved);
 }
 
 void shutdown_audio() {
@@ -176,18 +202,38 @@ void OPL_Config(uint8_t enable, uint16_t addr) {
 }
 
 static int music_fd = -1;
-static uint8_t music_buffer[512];
+// Two halves: update_music plays one while music_refill_buffer reads the
+// next chunk of the file into the other, outside the audio tick.
+#define MUSIC_HALF 256
+static uint8_t music_buffer[2 * MUSIC_HALF];
 static uint16_t music_buf_idx = 0;
-static uint16_t music_bytes_ready = 0; 
+static uint8_t music_half_ready = 0; // Bit per half holding unplayed data
+static uint8_t music_fill_next = 0;  // Half the next read goes into
 static uint16_t music_wait_ticks = 0;
 static bool music_error_state = false;
 
+static void music_read_half(uint8_t half) {
+    int res = read(music_fd, &music_buffer[half * MUSIC_HALF], MUSIC_HALF);
+
+    if (res < 0) {
+        int err = errno;
+        printf("Music: Read Error %d\n", err);
+        music_error_state = true;
+        return;
+    }
+
+    music_half_ready |= 1 << half;
+    music_fill_next = half ^ 1;
+}
+
 void music_init(const char* filename) {
     if (music_fd >= 0) close(music_fd);
     music_fd = open(filename, O_RDONLY);
     
     music_buf_idx = 0;
     music_wait_ticks = 0;
+    music_half_ready = 0;
+    music_fill_next = 0;
     music_error_state = (music_fd < 0);
 
     if (music_error_state) {
@@ -195,21 +241,18 @@ void music_init(const char* filename) {
         return;
     }
 
-    // 1. Read into the START of the buffer (index 0)
-    int res = read(music_fd, music_buffer, 512);
-                
-    if (res < 0) {
-        int err = errno;
-        printf("Music: Initial Read Error %d\n", err);
-        music_error_state = true;
-        return;
-    }
-
-    // 2. IMPORTANT: Update the count of valid bytes in the buffer
-    // Without this, the sequencer thinks the buffer is empty!
-    music_bytes_ready = res; 
+    // Start with both halves full
+    music_read_half(0);
+    if (!music_error_state) music_read_half(1);
     
-   //  printf("Music: Started. Initialized with %d bytes.\n", res);
+   //  printf("Music: Started.\n");
+}
+
+// Read-ahead: fill the half the sequencer is not playing. Cheap when there
+// is nothing to do, so it can run every frame.
+void music_refill_buffer() {
+    if (music_error_state || music_fd < 0) return;
+    if (!(music_half_ready & (1 << music_fill_next))) music_read_half(music_fill_next);
 }
 
 void update_music() {
@@ -222,19 +265,11 @@ void update_music() {
     if (music_wait_ticks == 0) {
         while (music_wait_ticks == 0) {
 
-            if (music_buf_idx >= 512){
-                // printf("Music: Buffer Refill Triggered.\n");
-                
-                int res = read(music_fd, &music_buffer, 512);
-                
-                if (res < 0) {
-                    int err = errno;
-                    printf("Music: Read Error %d\n", err);
-                    music_error_state = true;
-                    return;
-                }
-
-                music_buf_idx = 0;
+            uint8_t half = music_buf_idx / MUSIC_HALF;
+            if (!(music_half_ready & (1 << half))) {
+                // Read-ahead fell behind (or we just looped): read it now
+                music_read_half(half);
+                if (music_error_state) return;
             }
 
             // --- 4-BYTE PACKET ACCESS ---
@@ -244,12 +279,19 @@ void update_music() {
             uint8_t d_hi = music_buffer[music_buf_idx++];
             uint16_t delay = ((uint16_t)d_hi << 8) | d_lo;
 
+            // Finished a half: hand it back to the read-ahead
+            if ((music_buf_idx & (MUSIC_HALF - 1)) == 0) {
+                music_half_ready &= ~(1 << half);
+                music_buf_idx &= 2 * MUSIC_HALF - 1;
+            }
 
             if (reg == 0xFF && val == 0xFF) {
                 off_t seek_res = lseek(music_fd, 0, SEEK_SET);
 
                 printf("Music: Looping to start of track.\n");
-                music_buf_idx = 512; // Force buffer reload
+                music_buf_idx = 0; // Both halves are stale
+                music_half_ready = 0;
+                music_fill_next = 0;
                 delay = 1; // Small delay after loop
 
             } else {
@@ -25,6 +25,7 @@ extern void opl_write(uint8_t reg, uint8_t value);
 extern void update_music();
 extern void OPL_SetVolume(uint8_t chan, uint8_t velocity);
 extern void opl_init();
+extern bool opl_init_step(); // One chunk of opl_init; true when done
 extern void opl_fifo_clear();
 extern void opl_silence_all();
 extern void OPL_Config(uint8_t enable, uint16_t addr);
@@ -26,106 +26,75 @@ static int16_t safe_mul_shift(int16_t a, int16_t b) {
     // Low-overhead check:
     // With max radius 85 and max cos 256, product is 21760.
     // Fits in uint16 comfortably.
+    // |a| is a radius/offset/modulation (<= 127) and |b| a LUT value
+    // (<= 256), so this is a 16x8 quarter-square multiply.
     
-    uint16_t prod = ((uint16_t)a * (uint16_t)b) >> 8;
+    uint16_t prod = (uint16_t)(umul16x8((uint16_t)b, (uint8_t)a) >> 8);
     
     res = (int16_t)prod;
     if (sign < 0) res = -res;
     return res;
 }
 
-// Calculates 8-bit angle (0-255) from vector (x,y)
-// Maps 0..360 degrees to 0..255
-uint8_t vector_to_angle(int16_t x, int16_t y) {
-    if (x == 0 && y == 0) return 0;
-    
-    // Determine Octant
-    int16_t abs_x = (x < 0) ? -x : x;
-    int16_t abs_y = (y < 0) ? -y : y;
-    
-    uint8_t angle = 0;
-    
-    // 1. Reduce to First Octant (0..45 degrees)
-    // We want ratio = min / max.
-    // Result 0..32 (approx 45 degrees in 256-scale).
-    
-    int16_t max_val = (abs_x > abs_y) ? abs_x : abs_y;
-    int16_t min_val = (abs_x > abs_y) ? abs_y : abs_x;
-    
-    // Linear approximation: angle = (min * 32) / max
-    // Use prescaling to avoid 32-bit math
-    // We need (min * 32) to fit in 16-bit (max 32767).
-    // So min must be < 1024.
-    // Shift both down until max < 1024.
-    
-    uint8_t base_angle = 0;
-    
-    if (max_val > 0) {
-        // Prescale for 16-bit safety
-        // Max possible dx is screen width * 16 approx 5120.
-        // If > 1000, shift by 3 (div 8) to bring under 1000.
-        if (max_val > 1000) {
-            max_val >>= 3;
-            min_val >>= 3;
-        }
-        
-        // Final check to avoid divide by zero if shifted to 0 logic
-        if (max_val > 0) {
-            // (1000 * 32) = 32000 < 32767. Safe int16 multiply.
-            base_angle = (uint8_t)(( min_val * 32 ) / max_val);
-        }
-    }
-    
-    // 2. Map back to correct Octant
-    if (abs_x >= abs_y) {
-        // Octant 0, 3, 4, 7 (X dominant)
-        if (x >= 0) {
-            // Right side
-            if (y >= 0) angle = base_angle;         // Octant 0 (0..32)
-            else        angle = 256 - base_angle;   // Octant 7 (224..255)
-        } else {
-            // Left side
-            if (y >= 0) angle = 128 - base_angle;   // Octant 3 (96..128)
-            else        angle = 128 + base_angle;   // Octant 4 (128..160)
-        }
-    } else {
-        // Octant 1, 2, 5, 6 (Y dominant)
-        // Base angle calculates offset from Y axis (90 or 270)
-        // Since base_angle is min/max, it's measuring 'co-angle'.
-        // So we want (90 - angle) magnitude? 
-        // No, min/max gives angle from nearest axis.
-        // For (1, 10). min=1, max=10. angle=3.
-        // Correct is 87 deg (near 90) or 93.
-        // So we subtract/add base_angle from 64 (90 deg) or 192 (270 deg).
-        
-        if (y >= 0) {
-            // Top (y positive is down? No, usually y down in 2D gfx)
-            // Wait, standard Cartesian: Y up. Screen: Y down.
-            // Let's assume standard angles: 0=Right, 64=Down, 128=Left, 192=Up.
-            // If y > 0 (Down).
-            if (x >= 0) angle = 64 - base_angle;    // Octant 1
-            else        angle = 64 + base_angle;    // Octant 2
-        } else {
-            // Bottom (Up)
-            if (x >= 0) angle = 192 + base_angle;   // Octant 6
-            else        angle = 192 - base_angle;   // Octant 5
-        }
-    }
-    
-    return angle;
+// Apocenter spawn: the orbit's farthest point lies on (dx, dy).
+// Shared by spawn_worker, spawn_enemy and enemy respawn. Division-free:
+// the reciprocal and speed come from tables (see fixedmath.h).
+void solve_apocenter_orbit(int16_t dx, int16_t dy, uint8_t eccentricity, uint8_t min_radius,
+                           uint8_t *omega_out, uint16_t *angle_out, uint8_t *radius_out, uint8_t *speed_out) {
+    // 1. Calculate Click Angle (Phi)
+    uint8_t phi = vector_to_angle(dx, dy);
+    
+    // 2. Set Omega so Apocenter aligns with Click
+    // Std Apocenter is at angle 128 (Left), i.e. direction w + 128.
+    // We want direction Phi, so w = Phi - 128 = Phi + 128 (mod 256).
+    *omega_out = phi + 128;
+    
+    // 3. Set Angle to Apocenter
+    *angle_out = 128 << 8;
+    
+    // 4. Calculate Distance r (octagonal approximation)
+    int16_t adx = (dx < 0) ? -dx : dx;
+    int16_t ady = (dy < 0) ? -dy : dy;
+    int16_t r = (adx > ady) ? adx + ady/2 : ady + adx/2;
+    if (r > 255) r = 255; // Still clamps to 85 below
+    
+    // 5. Calculate a. r_apo = a(1+e), so a = r / (1+e).
+    uint8_t a_val = div_one_plus((uint8_t)r, eccentricity);
+    
+    // Clamp Radius
+    if (a_val > 85) a_val = 85; 
+    if (a_val < min_radius) a_val = min_radius;
+    
+    *radius_out = a_val;
+    
+    // Velocity Scaling (3500 / a)
+    *speed_out = orbit_speed(a_val);
 }
 
-// 16-bit safe geometric orbit update
-void update_geometric_orbit(int16_t *x_out, int16_t *y_out, uint16_t *angle_io, 
-                            uint8_t radius, uint8_t eccentricity, uint8_t speed, uint8_t omega) {
-    uint16_t ang_fixed = *angle_io;
-    uint8_t ang_int = (ang_fixed >> 8) & 0xFF; 
-    
+// modulation = speed * eccentricity. Both pos.
+static uint8_t orbit_mod_factor(uint8_t speed, uint8_t eccentricity) {
+    return (uint8_t)(umul8x8(speed, eccentricity) >> 8);
+}
+
+// delta = mod_factor * c. Signed.
+// At Pericenter (c=1), we want FASTER speed.
+// So Speed + Delta.
+// At Apocenter (c=-1), we want SLOWER speed.
+// Speed + (-Delta) = Speed - Delta.
+static int16_t orbit_speed_delta(uint8_t ang_int, uint8_t mod_factor) {
+    return safe_mul_shift((int16_t)mod_factor, SIN_LUT[(uint8_t)(ang_int + 64)]);
+}
+
+// Solves one orbit point: offset from the focus (pixels) and the
+// Kepler-lite speed modulation for angle index ang_int.
+static void solve_orbit_point(uint8_t ang_int, uint8_t radius, uint8_t eccentricity,
+                              uint8_t speed, uint8_t omega,
+                              int16_t *rot_x_out, int16_t *rot_y_out, int16_t *delta_out) {
     // 1. Semi-minor axis b
     // b = radius * (1 - e)
     // Both positive. Safe shift.
     uint16_t scale_b = 256 - eccentricity;
-    uint16_t b = ((uint16_t)radius * scale_b) >> 8;
+    uint16_t b = (uint16_t)(umul16x8(scale_b, radius) >> 8);
     
     // 2. Lookup Sine/Cosine
     int16_t c = SIN_LUT[(uint8_t)(ang_int + 64)];
@@ -147,7 +116,7 @@ void update_geometric_orbit(int16_t *x_out, int16_t *y_out, uint16_t *angle_io,
     // If we want +a to map to a(1-e), we subtract ae.
     // X_focus = X_ellipse - ae.
     
-    int16_t offset = ((uint16_t)radius * (uint16_t)eccentricity) >> 8;
+    int16_t offset = umul8x8(radius, eccentricity) >> 8;
     rel_x -= offset;
     
     // Apply Rotation by Omega (Argument of Periapsis)
@@ -157,26 +126,79 @@ void update_geometric_orbit(int16_t *x_out, int16_t *y_out, uint16_t *angle_io,
     int16_t cos_om = SIN_LUT[(uint8_t)(omega + 64)];
     int16_t sin_om = SIN_LUT[omega];
     
-    int16_t rot_x = safe_mul_shift(rel_x, cos_om) - safe_mul_shift(rel_y, sin_om);
-    int16_t rot_y = safe_mul_shift(rel_x, sin_om) + safe_mul_shift(rel_y, cos_om);
-    
-    *x_out = (160 + rot_x) << 4;
-    *y_out = (90 + rot_y) << 4;
-    
-    // 4. Update Angle (Kepler-lite)
-    // modulation = speed * eccentricity. Both pos.
-    uint16_t mod_factor = ((uint16_t)speed * (uint16_t)eccentricity) >> 8;
-    
-    // delta = mod_factor * c. Signed.
-    // At Pericenter (c=1), we want FASTER speed.
-    // So Speed + Delta.
-    // At Apocenter (c=-1), we want SLOWER speed.
-    // Speed + (-Delta) = Speed - Delta.
-    
-    int16_t delta_mod = safe_mul_shift((int16_t)mod_factor, c);
+    *rot_x_out = safe_mul_shift(rel_x, cos_om) - safe_mul_shift(rel_y, sin_om);
+    *rot_y_out = safe_mul_shift(rel_x, sin_om) + safe_mul_shift(rel_y, cos_om);
     
+    // 4. Speed modulation (Kepler-lite)
+    *delta_out = orbit_speed_delta(ang_int, orbit_mod_factor(speed, eccentricity));
+}
+
+// Advances the 8.8 angle by speed + delta, with the usual floor.
+static uint16_t advance_orbit_angle(uint16_t ang_fixed, uint8_t speed, int16_t delta_mod) {
     int16_t new_speed = (int16_t)speed + delta_mod;   
     if (new_speed < 20) new_speed = 20;
 
-    *angle_io = ang_fixed + (uint16_t)new_speed;
+    return ang_fixed + (uint16_t)new_speed;
+}
+
+// Clamp for ephemeris storage. |offset| <= a(1+e) <= 85 * 1.5, so this
+// only guards against LUT rounding.
+static int8_t clamp_s8(int16_t v) {
+    if (v > 127) return 127;
+    if (v < -128) return -128;
+    return (int8_t)v;
+}
+
+void orbit_cache_reset(orbit_cache_t *cache) {
+    for (uint8_t k = 0; k < sizeof(cache->valid); k++) {
+        cache->valid[k] = 0;
+    }
+}
+
+// Each angle index is solved once per spawn and then read back. Orbit elements are frozen at spawn,
+// so the cache stays valid until orbit_cache_reset.
+void update_cached_orbit(orbit_cache_t *cache, int16_t *x_out, int16_t *y_out, uint16_t *angle_io, 
+                         uint8_t radius, uint8_t eccentricity, uint8_t speed, uint8_t omega) {
+    uint16_t ang_fixed = *angle_io;
+    uint8_t ang_int = (ang_fixed >> 8) & 0xFF; 
+    uint8_t bit = (uint8_t)(1 << (ang_int & 7));
+    uint8_t *valid = &cache->valid[ang_int >> 3];
+    
+    if (!(*valid & bit)) {
+        // Miss: solve this index and remember it
+        int16_t rot_x, rot_y, delta_mod;
+        solve_orbit_point(ang_int, radius, eccentricity, speed, omega, &rot_x, &rot_y, &delta_mod);
+        cache->dx[ang_int] = clamp_s8(rot_x);
+        cache->dy[ang_int] = clamp_s8(rot_y);
+        cache->mod = orbit_mod_factor(speed, eccentricity);
+        *valid |= bit;
+    }
+    
+    *x_out = (160 + cache->dx[ang_int]) << 4;
+    *y_out = (90 + cache->dy[ang_int]) << 4;
+    
+    *angle_io = advance_orbit_angle(ang_fixed, speed, orbit_speed_delta(ang_int, cache->mod));
+}
+
+void sweep_sort_x(uint8_t *order, uint8_t n, const int16_t *x) {
+    for (uint8_t k = 1; k < n; k++) {
+        uint8_t s = order[k];
+        int16_t xs = x[s];
+        uint8_t j = k;
+        while (j > 0 && x[order[j - 1]] > xs) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = s;
+    }
+}
+
+uint8_t sweep_lower_bound(const uint8_t *order, uint8_t n, const int16_t *x, int16_t x_min) {
+    uint8_t lo = 0, hi = n;
+    while (lo < hi) {
+        uint8_t mid = (lo + hi) >> 1;
+        if (x[order[mid]] < x_min) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
 }
@@ -2,19 +2,53 @@
 #define PHYSICS_H
 
 #include <stdint.h>
+#include "fixedmath.h" // vector_to_angle
 
 /*
- * update_geometric_orbit
- * Calculates position using parametric ellipse equations:
+ * Orbit ephemeris cache
+ * Positions come from the parametric ellipse equations:
  * x = a * cos(t)
  * y = b * sin(t)
- * where b varies with eccentricity.
- * 
- * 16-bit safe. No division.
+ * where b varies with eccentricity. 16-bit safe. No division.
+ *
+ * One orbit's worth of positions (offset from the focus, pixels),
+ * indexed by the angle's integer part. Entries are solved on first
+ * visit, so a spawn costs one 32-byte clear instead of 256 solves in the
+ * vsync block. The speed modulation is one multiply by the cached
+ * speed * e factor, so it is recomputed each frame rather than stored:
+ * 545 bytes per entity, 8.7 KB for 8 enemies and 8 workers.
  */
-void update_geometric_orbit(int16_t *x_out, int16_t *y_out, uint16_t *angle_io, uint8_t radius, uint8_t eccentricity, uint8_t speed, uint8_t omega);
+typedef struct {
+    uint8_t valid[32]; // 1 bit per angle index
+    uint8_t mod;       // speed * eccentricity >> 8, set on the first solve
+    int8_t dx[256];
+    int8_t dy[256];
+} orbit_cache_t;
 
-// Calculate angle 0..255 from vector x,y
-uint8_t vector_to_angle(int16_t x, int16_t y);
+// Invalidate all entries. Call on spawn/respawn (orbit elements changed).
+void orbit_cache_reset(orbit_cache_t *cache);
+
+// Position (12.4 fixed point) for the current angle, then advance the angle.
+void update_cached_orbit(orbit_cache_t *cache, int16_t *x_out, int16_t *y_out, uint16_t *angle_io, uint8_t radius, uint8_t eccentricity, uint8_t speed, uint8_t omega);
+
+/*
+ * solve_apocenter_orbit
+ * Orbit elements for a spawn whose apocenter is at (dx, dy) pixels from
+ * the focus: omega, starting angle, semi-major axis (clamped
+ * min_radius..85) and base speed. Table-driven, no division.
+ */
+void solve_apocenter_orbit(int16_t dx, int16_t dy, uint8_t eccentricity, uint8_t min_radius,
+                           uint8_t *omega_out, uint16_t *angle_out, uint8_t *radius_out, uint8_t *speed_out);
+
+/*
+ * Sort-and-sweep broadphase on x
+ * order[] is a permutation of slots 0..n-1. sweep_sort_x re-sorts it by
+ * x[slot] with an insertion sort: orbits move a few pixels per frame, so
+ * last frame's order is nearly sorted and this is about n compares.
+ * sweep_lower_bound returns the first position in order[] whose x is
+ * >= x_min; a caller scans from there until x leaves its window.
+ */
+void sweep_sort_x(uint8_t *order, uint8_t n, const int16_t *x);
+uint8_t sweep_lower_bound(const uint8_t *order, uint8_t n, const int16_t *x, int16_t x_min);
 
 #endif
@@ -0,0 +1,83 @@
+#include <rp6502.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "sched.h"
+
+// Registered tasks, sorted by priority (stable for equal priorities)
+static sched_task_t *tasks[SCHED_MAX_TASKS];
+static uint8_t task_count;
+
+void sched_add(sched_task_t *task)
+{
+    if (task_count >= SCHED_MAX_TASKS) {
+        // A task that silently never runs is worse than stopping here
+        printf("sched: no slot for %s, raise SCHED_MAX_TASKS (%u)\n", task->name, SCHED_MAX_TASKS);
+        exit(1);
+    }
+
+    uint8_t k = task_count++;
+    while (k > 0 && tasks[k - 1]->priority > task->priority) {
+        tasks[k] = tasks[k - 1];
+        k--;
+    }
+    tasks[k] = task;
+    task->due = 0; // First run on the next vsync
+    task->runs = 0;
+    task->overruns = 0;
+}
+
+void sched_stop(sched_task_t *task)
+{
+    task->run = 0; // Stays registered, so sched_report still lists it
+}
+
+void sched_run(void)
+{
+    uint8_t vsync_last = RIA.vsync;
+
+    while (1) {
+        uint8_t vsync_now = RIA.vsync;
+        if (vsync_now != vsync_last) {
+            // Several edges may have passed; each task still runs once
+            uint8_t elapsed = vsync_now - vsync_last;
+            vsync_last = vsync_now;
+
+            for (uint8_t k = 0; k < task_count; k++) {
+                sched_task_t *t = tasks[k];
+                if (t->period == 0 || !t->run) continue;
+
+                if (t->due > elapsed) {
+                    t->due -= elapsed;
+                    continue;
+                }
+                t->due = t->period;
+
+                uint8_t start = RIA.vsync;
+                t->run();
+                t->runs++;
+                if ((uint8_t)(RIA.vsync - start) > t->budget) t->overruns++;
+            }
+        }
+
+        for (uint8_t k = 0; k < task_count; k++) {
+            sched_task_t *t = tasks[k];
+            if (t->period != 0 || !t->run) continue;
+
+            uint8_t start = RIA.vsync;
+            for (uint8_t n = 0; n < t->budget; n++) t->run();
+            t->runs++;
+            // A batch spanning two edges made the periodic tasks miss one
+            if ((uint8_t)(RIA.vsync - start) > 1) t->overruns++;
+        }
+    }
+}
+
+void sched_report(void)
+{
+    for (uint8_t k = 0; k < task_count; k++) {
+        sched_task_t *t = tasks[k];
+        printf("%-10s runs %5u overruns %5u\n", t->name, t->runs, t->overruns);
+    }
+}
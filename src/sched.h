@@ -0,0 +1,53 @@
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+
+/*
+ * Cooperative scheduler for the main loop
+ * Periodic tasks run on vsync edges, lowest priority value first, each
+ * every `period` vsyncs. Idle tasks (period 0) fill the time between
+ * edges: each poll runs every idle task `budget` times before RIA.vsync is
+ * read again, so resumable work like galaxy_tick is not re-polled per
+ * slice.
+ *
+ * The only clock is RIA.vsync, so budgets for periodic tasks are in
+ * vsyncs: a task overruns when more than `budget` edges pass while it
+ * runs (budget 0: it must finish inside the frame it started in). An idle
+ * batch overruns when it spans two edges, as the periodic tasks then
+ * missed a frame.
+ */
+
+// The game registers at most 8 (audio, sprites, commit, input, music,
+// stream, galaxy and boot itself); the rest is headroom at 2 bytes a slot.
+// sched_add halts with a message when they run out.
+#define SCHED_MAX_TASKS 12
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+    uint8_t priority; // Lower runs first
+    uint8_t period;   // Vsyncs between runs; 0 = idle task
+    uint8_t budget;   // Periodic: vsyncs it may span. Idle: runs per poll
+    // Scheduler state
+    uint8_t due;      // Vsyncs until the next run
+    uint16_t runs;
+    uint16_t overruns;
+} sched_task_t;
+
+// Register a task. The struct must outlive the scheduler (static).
+// Prints and exits if all SCHED_MAX_TASKS slots are taken.
+// A running task may add others that sort after it (priority >= its own);
+// they first run on this same pass.
+void sched_add(sched_task_t *task);
+
+// Never run the task again. Safe from inside the task itself.
+void sched_stop(sched_task_t *task);
+
+// Run forever.
+void sched_run(void);
+
+// Print runs and overruns per task to the console.
+void sched_report(void);
+
+#endif // SCHED_H
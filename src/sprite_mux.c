@@ -0,0 +1,165 @@
+#include <rp6502.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sprite_mux.h"
+#include "tables.h" // SIN_LUT
+
+_Static_assert(SPRITE_MUX_PLAIN_BASE + SPRITE_MUX_PLAIN_SLOTS * sizeof(vga_mode4_sprite_t) <=
+               XRAM_SPRITE_CONFIGS_ADDR + XRAM_SPRITE_CONFIGS_SIZE,
+               "sprite configs outgrow SPRITE_CONFIGS in src/xram.layout");
+
+// Handle flags
+#define MUX_USED    1 // Requested, not released
+#define MUX_PLACED  2 // Placed this frame
+#define MUX_ROTATED 4 // Wants an affine slot
+
+// Per-handle placement, struct-of-arrays like the entities
+static uint8_t mux_flags[SPRITE_MUX_HANDLES];
+static uint8_t mux_prio[SPRITE_MUX_HANDLES];
+static int16_t mux_x[SPRITE_MUX_HANDLES], mux_y[SPRITE_MUX_HANDLES];
+static uint16_t mux_ptr[SPRITE_MUX_HANDLES];
+static uint8_t mux_log_size[SPRITE_MUX_HANDLES];
+static uint8_t mux_angle[SPRITE_MUX_HANDLES];
+
+// Slots filled last frame; anything past this frame's count gets parked
+static uint8_t affine_used, plain_used;
+
+#define AFFINE_CONFIG(slot) (SPRITE_MUX_AFFINE_BASE + (slot) * sizeof(vga_mode4_asprite_t))
+#define PLAIN_CONFIG(slot)  (SPRITE_MUX_PLAIN_BASE + (slot) * sizeof(vga_mode4_sprite_t))
+
+void sprite_mux_init(void)
+{
+    for (uint8_t s = 0; s < SPRITE_MUX_AFFINE_SLOTS; s++) {
+        xram0_struct_set(AFFINE_CONFIG(s), vga_mode4_asprite_t, y_pos_px, -32); // Offscreen
+    }
+    for (uint8_t s = 0; s < SPRITE_MUX_PLAIN_SLOTS; s++) {
+        xram0_struct_set(PLAIN_CONFIG(s), vga_mode4_sprite_t, y_pos_px, -32);
+    }
+    affine_used = 0;
+    plain_used = 0;
+
+    // Mode 4 registers: mode, options (1 = affine), config ptr, length, plane
+    // Plane 1: plain pool
+    xregn(1, 0, 1, 5, 4, 0, SPRITE_MUX_PLAIN_BASE, SPRITE_MUX_PLAIN_SLOTS, 1);
+    // Plane 2: affine pool + reticle
+    xregn(1, 0, 1, 5, 4, 1, SPRITE_MUX_AFFINE_BASE, SPRITE_MUX_AFFINE_SLOTS + 1, 2);
+}
+
+sprite_handle_t sprite_request(uint8_t priority)
+{
+    for (uint8_t h = 0; h < SPRITE_MUX_HANDLES; h++) {
+        if (!(mux_flags[h] & MUX_USED)) {
+            mux_flags[h] = MUX_USED;
+            mux_prio[h] = (priority > SPRITE_PRIO_MAX) ? SPRITE_PRIO_MAX : priority;
+            return h;
+        }
+    }
+    return SPRITE_NO_HANDLE;
+}
+
+void sprite_release(sprite_handle_t h)
+{
+    if (h < SPRITE_MUX_HANDLES) mux_flags[h] = 0;
+}
+
+void sprite_place(sprite_handle_t h, int16_t x, int16_t y, uint16_t ptr, uint8_t log_size)
+{
+    if (h >= SPRITE_MUX_HANDLES) return;
+    mux_flags[h] = MUX_USED | MUX_PLACED;
+    mux_x[h] = x;
+    mux_y[h] = y;
+    mux_ptr[h] = ptr;
+    mux_log_size[h] = log_size;
+}
+
+void sprite_place_rotated(sprite_handle_t h, int16_t x, int16_t y, uint16_t ptr, uint8_t log_size, uint8_t angle)
+{
+    if (h >= SPRITE_MUX_HANDLES) return;
+    sprite_place(h, x, y, ptr, log_size);
+    mux_flags[h] |= MUX_ROTATED;
+    mux_angle[h] = angle;
+}
+
+static void write_affine(uint8_t slot, uint8_t h)
+{
+    unsigned config_addr = AFFINE_CONFIG(slot);
+
+    // Optimized Affine (Scale = 256 means 1.0, so A=c, etc.)
+    int16_t c = SIN_LUT[(uint8_t)(mux_angle[h] + 64)]; // cos
+    int16_t s = SIN_LUT[mux_angle[h]]; // sin
+
+    int16_t A = c;
+    int16_t B = -s;
+    int16_t C = s;
+    int16_t D = c;
+
+    // Rotate about the centre: half = size / 2, T = (half << 8) - M * half
+    // (16x16: 2048 - A*8 - B*8, no 32-bit math needed)
+    int16_t half = 1 << (mux_log_size[h] - 1);
+    int16_t TX = (half << 8) - (A * half) - (B * half);
+    int16_t TY = (half << 8) - (C * half) - (D * half);
+
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[0], A);
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[1], B);
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[2], TX);
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[3], C);
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[4], D);
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[5], TY);
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, x_pos_px, mux_x[h]);
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, y_pos_px, mux_y[h]);
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, xram_sprite_ptr, mux_ptr[h]);
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, log_size, mux_log_size[h]);
+    xram0_struct_set(config_addr, vga_mode4_asprite_t, has_opacity_metadata, false);
+}
+
+static void write_plain(uint8_t slot, uint8_t h)
+{
+    unsigned config_addr = PLAIN_CONFIG(slot);
+    xram0_struct_set(config_addr, vga_mode4_sprite_t, x_pos_px, mux_x[h]);
+    xram0_struct_set(config_addr, vga_mode4_sprite_t, y_pos_px, mux_y[h]);
+    xram0_struct_set(config_addr, vga_mode4_sprite_t, xram_sprite_ptr, mux_ptr[h]);
+    xram0_struct_set(config_addr, vga_mode4_sprite_t, log_size, mux_log_size[h]);
+    xram0_struct_set(config_addr, vga_mode4_sprite_t, has_opacity_metadata, false);
+}
+
+void sprite_mux_commit(void)
+{
+    uint8_t na = 0, np = 0;
+
+    // Affine slots go to rotated placements, highest priority first. When
+    // they all fit (the usual case) that is a single pass.
+    uint8_t want = 0;
+    for (uint8_t h = 0; h < SPRITE_MUX_HANDLES; h++) {
+        if ((mux_flags[h] & (MUX_PLACED | MUX_ROTATED)) == (MUX_PLACED | MUX_ROTATED)) want++;
+    }
+    uint8_t prio = (want > SPRITE_MUX_AFFINE_SLOTS) ? SPRITE_PRIO_MAX : 0;
+    for (;;) {
+        for (uint8_t h = 0; h < SPRITE_MUX_HANDLES && na < SPRITE_MUX_AFFINE_SLOTS; h++) {
+            if ((mux_flags[h] & (MUX_PLACED | MUX_ROTATED)) == (MUX_PLACED | MUX_ROTATED) &&
+                mux_prio[h] >= prio) {
+                write_affine(na++, h);
+                mux_flags[h] &= ~MUX_PLACED;
+            }
+        }
+        if (prio == 0 || na == SPRITE_MUX_AFFINE_SLOTS) break;
+        prio--;
+    }
+
+    // Everything else, including rotated overflow, is drawn plain.
+    // Past the plain budget, placements are dropped for this frame.
+    for (uint8_t h = 0; h < SPRITE_MUX_HANDLES; h++) {
+        if ((mux_flags[h] & MUX_PLACED) && np < SPRITE_MUX_PLAIN_SLOTS) write_plain(np++, h);
+        mux_flags[h] &= MUX_USED;
+    }
+
+    // Park slots that were in use last frame but not this one
+    for (uint8_t s = na; s < affine_used; s++) {
+        xram0_struct_set(AFFINE_CONFIG(s), vga_mode4_asprite_t, y_pos_px, -32);
+    }
+    for (uint8_t s = np; s < plain_used; s++) {
+        xram0_struct_set(PLAIN_CONFIG(s), vga_mode4_sprite_t, y_pos_px, -32);
+    }
+    affine_used = na;
+    plain_used = np;
+}
@@ -0,0 +1,61 @@
+#ifndef SPRITE_MUX_H
+#define SPRITE_MUX_H
+
+#include <rp6502.h>
+#include <stdint.h>
+#include "xram_map.h"
+
+/*
+ * Sprite multiplexer
+ * Entities hold logical sprite handles; each frame they place the handles
+ * they want drawn and sprite_mux_commit packs those into the hardware
+ * config tables. Two Mode 4 planes:
+ *
+ *   Plane 1: plain sprites, SPRITE_MUX_PLAIN_SLOTS configs
+ *   Plane 2: affine sprites, SPRITE_MUX_AFFINE_SLOTS configs, then the
+ *            reticle (always last, so it draws over everything)
+ *
+ * A rotated placement gets an affine slot while the budget lasts, higher
+ * priority first; the rest fall back to plain slots, drawn unrotated from
+ * the same art. Handles not placed this frame are not drawn, and configs
+ * left over from the last frame are parked off screen.
+ */
+
+typedef uint8_t sprite_handle_t;
+#define SPRITE_NO_HANDLE 0xFF
+#define SPRITE_MUX_HANDLES 32
+
+// Placement priority, 0..SPRITE_PRIO_MAX. Higher keeps affine longer.
+#define SPRITE_PRIO_MAX 3
+
+#ifdef USE_PREROTATED_SPRITES
+// Entities are all plain; plane 2 only carries the reticle.
+#define SPRITE_MUX_AFFINE_SLOTS 0
+#define SPRITE_MUX_PLAIN_SLOTS  16
+#else
+#define SPRITE_MUX_AFFINE_SLOTS 16
+#define SPRITE_MUX_PLAIN_SLOTS  16
+#endif
+
+// Config tables fill the SPRITE_CONFIGS region of src/xram.layout
+#define SPRITE_MUX_AFFINE_BASE XRAM_SPRITE_CONFIGS_ADDR
+#define SPRITE_MUX_RETICLE_ADDR (SPRITE_MUX_AFFINE_BASE + SPRITE_MUX_AFFINE_SLOTS * sizeof(vga_mode4_asprite_t))
+#define SPRITE_MUX_PLAIN_BASE  (SPRITE_MUX_RETICLE_ADDR + sizeof(vga_mode4_asprite_t))
+
+// Point planes 1 and 2 at the tables and park every slot.
+void sprite_mux_init(void);
+
+// SPRITE_NO_HANDLE when all handles are taken.
+sprite_handle_t sprite_request(uint8_t priority);
+void sprite_release(sprite_handle_t h);
+
+// Draw h this frame. x, y are the top-left in pixels, ptr the XRAM art.
+// sprite_place_rotated asks for an affine slot, rotated by angle (0..255)
+// about the centre.
+void sprite_place(sprite_handle_t h, int16_t x, int16_t y, uint16_t ptr, uint8_t log_size);
+void sprite_place_rotated(sprite_handle_t h, int16_t x, int16_t y, uint16_t ptr, uint8_t log_size, uint8_t angle);
+
+// Assign slots for this frame's placements and write the configs.
+void sprite_mux_commit(void);
+
+#endif // SPRITE_MUX_H
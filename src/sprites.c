@@ -10,9 +10,11 @@
 #include "constants.h"
 
 #include "physics.h"
+#include "fixedmath.h"
+#include "sprite_mux.h"
 
-#define SPRITE_CONFIG_ADDR 0xFD00
-#define SPRITE_DATA_ADDR   0xF500 
+#define SPRITE_CONFIG_ADDR SPRITE_MUX_RETICLE_ADDR // Last config on plane 2
+#define SPRITE_DATA_ADDR   XRAM_RETICLE_ART_ADDR
 
 static uint8_t current_eccentricity = 0; // 0..128
 
@@ -23,7 +25,12 @@ static uint8_t current_eccentricity = 0; // 0..128
 bool check_collision(int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
     int16_t dx = (x1 - x2) >> 4;
     int16_t dy = (y1 - y2) >> 4;
-    return ((dx*dx + dy*dy) < 200); // Slightly forgiving
+    // Box early-out: 15*15 > 200, so only |d| <= 14 can collide.
+    // That keeps both squares in 8x8 range.
+    if (dx < 0) dx = -dx;
+    if (dy < 0) dy = -dy;
+    if (dx >= 15 || dy >= 15) return false;
+    return ((umul8x8((uint8_t)dx, (uint8_t)dx) + umul8x8((uint8_t)dy, (uint8_t)dy)) < 200); // Slightly forgiving
 }
 
 static uint16_t sprite_angle = 0; // 0..255
@@ -31,34 +38,107 @@ static uint16_t pulse_time = 0;
 int16_t reticle_x = 144; // Start center
 int16_t reticle_y = 74;
 
-// Enemy & Worker Data (Shifted to 0xE500 base)
-#define ENEMY_DATA_ADDR    0xE500
-#define WORKER_DATA_ADDR   0xED00
+// Sprite art, placed by src/xram.layout
+// Pre-rotated atlases (see CMakeLists.txt):
+// Enemy: SPRITE_HEADINGS x 512, heading 0 = art as drawn (facing up)
+// Worker: 2 x 512, one idle frame per type, not rotated
+#define ENEMY_DATA_ADDR    XRAM_ENEMY_ART_ADDR
+#define WORKER_DATA_ADDR   XRAM_WORKER_ART_ADDR
+
+// Hardware configs are handed out by the multiplexer (sprite_mux.h).
+// Enemies outrank workers for affine slots: their rotation shows heading,
+// a worker's spin is decoration.
+#define ENEMY_SPRITE_PRIO  2
+#define WORKER_SPRITE_PRIO 1
+
+// Enemy storage (see sprites.h)
+int16_t enemy_x[MAX_ENEMIES], enemy_y[MAX_ENEMIES]; // 12.4 Fixed Point
+static uint16_t enemy_angle[MAX_ENEMIES];       // 8.8 Fixed Point (0-255 integer part)
+static uint8_t enemy_omega[MAX_ENEMIES];        // Argument of Periapsis (Orientation)
+static uint8_t enemy_radius[MAX_ENEMIES];       // Semi-major axis (pixels)
+static uint8_t enemy_eccentricity[MAX_ENEMIES]; // Orbital Eccentricity (0-255, usually 0-128)
+static uint8_t enemy_speed[MAX_ENEMIES];        // Base orbital speed (8.8)
+static int16_t enemy_timer[MAX_ENEMIES];        // Animation, or respawn delay while dead
+static uint8_t enemy_frame[MAX_ENEMIES];
+static uint8_t enemy_visual_angle[MAX_ENEMIES]; // For directional rotation
+uint8_t enemy_active;
+uint8_t enemy_live[MAX_ENEMIES];
+uint8_t enemy_live_count;
+static uint8_t enemy_respawn; // Bit e set: dead enemy e has a respawn timer running
+
+// Worker storage (see sprites.h)
+int16_t worker_x[MAX_WORKERS], worker_y[MAX_WORKERS]; // 12.4 Fixed Point
+uint8_t worker_type[MAX_WORKERS];
+static uint16_t worker_angle[MAX_WORKERS];       // 8.8 Fixed Point
+static uint8_t worker_omega[MAX_WORKERS];        // Argument of Periapsis
+static uint8_t worker_radius[MAX_WORKERS];       // Semi-major axis (pixels)
+static uint8_t worker_eccentricity[MAX_WORKERS]; // Orbital Eccentricity
+static uint8_t worker_speed[MAX_WORKERS];        // Base orbital speed
+static int16_t worker_timer[MAX_WORKERS];
+static uint8_t worker_frame[MAX_WORKERS];
+uint8_t worker_active;
+uint8_t worker_live[MAX_WORKERS];
+uint8_t worker_live_count;
+uint8_t gardener_live[MAX_WORKERS];
+uint8_t gardener_count;
+
+// Sprite handles, SPRITE_NO_HANDLE while dead
+static sprite_handle_t enemy_sprite[MAX_ENEMIES];
+static sprite_handle_t worker_sprite[MAX_WORKERS];
+
+// Orbit ephemeris caches (reset on every spawn/respawn)
+static orbit_cache_t enemy_orbits[MAX_ENEMIES];
+static orbit_cache_t worker_orbits[MAX_WORKERS];
+
+// Rebuild the live lists from the active masks. Only called when a slot
+// is spawned or killed, never per frame.
+static void enemies_relist(void) {
+    uint8_t n = 0;
+    for (uint8_t e = 0; e < MAX_ENEMIES; e++) {
+        if (enemy_active & (1 << e)) enemy_live[n++] = e;
+    }
+    enemy_live_count = n;
+}
+
+static void workers_relist(void) {
+    uint8_t n = 0, g = 0;
+    for (uint8_t w = 0; w < MAX_WORKERS; w++) {
+        if (worker_active & (1 << w)) {
+            worker_live[n++] = w;
+            if (worker_type[w] == 1) gardener_live[g++] = w;
+        }
+    }
+    worker_live_count = n;
+    gardener_count = g;
+}
 
-// Config Structs (Moved to 0xE310 to follow Bitmap Config)
-// Affine Sprite Stride is 20 bytes! 8 * 20 = 160 (0xA0)
-#define ENEMY_CONFIG_BASE  0xE310 
-#define WORKER_CONFIG_BASE 0xE3B0 // 0xE310 + 0xA0 = 0xE3B0       
+// A dead entity hands its sprite back; unplaced sprites are not drawn.
+static void kill_enemy(uint8_t e) {
+    enemy_active &= ~(1 << e);
+    enemy_timer[e] = 300; // Respawn Delay (5s)
+    enemy_respawn |= (1 << e);
+    sprite_release(enemy_sprite[e]);
+    enemy_sprite[e] = SPRITE_NO_HANDLE;
+    enemies_relist();
+}
 
-enemy_t enemies[MAX_ENEMIES];
-worker_t workers[MAX_WORKERS];
+// Leaves the live lists stale: update_workers is walking them, so it
+// skips cleared slots and relists once at the end.
+static void kill_worker(uint8_t w) {
+    worker_active &= ~(1 << w);
+    sprite_release(worker_sprite[w]);
+    worker_sprite[w] = SPRITE_NO_HANDLE;
+}
 
 void spawn_worker(uint8_t type, int16_t x, int16_t y) {
     // CAP GARDENERS (Type 1) to 7
-    if (type == 1) {
-        int count = 0;
-        for (int k = 0; k < MAX_WORKERS; k++) {
-            if (workers[k].active && workers[k].type == 1) count++;
-        }
-        if (count >= 7) return; // Cap reached
-    }
+    if (type == 1 && gardener_count >= 7) return; // Cap reached
 
-    for (int i = 0; i < MAX_WORKERS; i++) {
-        if (!workers[i].active) {
-            workers[i].active = true;
-            workers[i].type = type;
-            
-            workers[i].type = type;
+    for (uint8_t i = 0; i < MAX_WORKERS; i++) {
+        if (!(worker_active & (1 << i))) {
+            worker_active |= (1 << i);
+            worker_type[i] = type;
+            worker_sprite[i] = sprite_request(WORKER_SPRITE_PRIO);
             
             // Set orbit parameters (Geometric)
             // Input x,y is Reticle Top-Left (32x32)
@@ -74,184 +154,140 @@ void spawn_worker(uint8_t type, int16_t x, int16_t y) {
             int16_t dy = center_y - cy;
             
             // Freeze Eccentricity at Spawn
-            workers[i].eccentricity = current_eccentricity;
+            worker_eccentricity[i] = current_eccentricity;
             
             // Keplerian Parameter Extraction (Rotated Apocenter)
-            // We want orbit to pass through (dx, dy) relative to Focus.
-            // AND we want (dx, dy) to be the Apocenter (farthest point).
-            
-            // 1. Calculate Click Angle (Phi)
-            uint8_t phi = vector_to_angle(dx, dy);
-            
-            // 2. Set Omega so Apocenter aligns with Click
-            // Std Apocenter is at angle 128 (Left).
-            // We want Apocenter at Phi.
-            // Angle = Phi.
-            // Rotated Angle = Angle - Omega? No.
-            // x_rot = x cos w - y sin w.
-            // If x is Left (-a(1+e), 0). Angle 128.
-            // We want Result to be Direction Phi.
-            // - [cos w, sin w] is direction w + 128.
-            // So if we want direction Phi, then Phi = w + 128.
-            // w = Phi - 128 = Phi + 128 (mod 256).
-            workers[i].omega = phi + 128;
-            
-            // 3. Set Angle to Apocenter
-            workers[i].angle = 128 << 8; 
-            
-            // 4. Calculate Distance r
-            int16_t adx = (dx < 0) ? -dx : dx;
-            int16_t ady = (dy < 0) ? -dy : dy;
-            int16_t r = (adx > ady) ? adx + ady/2 : ady + adx/2;
-            
-            // 5. Calculate a. r_apo = a(1+e).
-            // a = r / (1+e).
-            // In 8.8 fixed point: 1.0 = 256.
-            // a = (r * 256) / (256 + e).
-            
-            uint16_t denom = 256 + workers[i].eccentricity;
-            int32_t num = (int32_t)r * 256;
-            int16_t a_val = (int16_t)(num / denom);
-            
-            // Clamp Radius
-            if (a_val > 85) a_val = 85; 
-            if (a_val < 20) a_val = 20;
-            
-            workers[i].radius = (uint8_t)a_val;
-            
-            // Velocity Scaling
-            uint16_t calc_speed = 3500 / workers[i].radius;
-            if (calc_speed > 255) calc_speed = 255;
-            if (calc_speed < 20) calc_speed = 20;
-            workers[i].speed = (uint8_t)calc_speed;
+            // Orbit passes through (dx, dy) as its farthest point.
+            solve_apocenter_orbit(dx, dy, worker_eccentricity[i], 20,
+                                  &worker_omega[i], &worker_angle[i],
+                                  &worker_radius[i], &worker_speed[i]);
             
             // Initial position calculate
-            update_geometric_orbit(&workers[i].x, &workers[i].y, &workers[i].angle, 
-                                   workers[i].radius, current_eccentricity, workers[i].speed, workers[i].omega);
+            orbit_cache_reset(&worker_orbits[i]);
+            update_cached_orbit(&worker_orbits[i], &worker_x[i], &worker_y[i], &worker_angle[i], 
+                                worker_radius[i], current_eccentricity, worker_speed[i], worker_omega[i]);
 
-            workers[i].frame = (type == 0) ? 0 : 2; 
-            workers[i].timer = 0;
+            worker_frame[i] = (type == 0) ? 0 : 2; 
+            worker_timer[i] = 0;
+            workers_relist();
             return;
         }
     }
 }
 
+// Guardian collisions: sort-and-sweep on x (physics.h). check_collision
+// can only pass with |dx >> 4| <= 14, so nothing outside +-COLLIDE_REACH
+// (12.4) is tested. The order arrays cover every slot, dead ones too, and
+// are re-sorted each frame from last frame's nearly sorted order.
+#define COLLIDE_REACH (15 << 4)
+#define NO_HIT 0xFF
+
+static uint8_t enemy_by_x[MAX_ENEMIES];
+static uint8_t worker_by_x[MAX_WORKERS];
+
+// Lowest live slot (other than skip) colliding with (x, y), or NO_HIT.
+// Lowest slot wins, as in a plain slot-order scan.
+static uint8_t first_hit(const uint8_t *order, uint8_t n, const int16_t *xs, const int16_t *ys,
+                         uint8_t live, uint8_t skip, int16_t x, int16_t y) {
+    uint8_t hit = NO_HIT;
+    for (uint8_t k = sweep_lower_bound(order, n, xs, x - COLLIDE_REACH); k < n; k++) {
+        uint8_t s = order[k];
+        if (xs[s] > x + COLLIDE_REACH) break;
+        if (s < hit && s != skip && (live & (1 << s)) &&
+            check_collision(x, y, xs[s], ys[s])) hit = s;
+    }
+    return hit;
+}
+
 void update_workers(void) {
-    int16_t cx = 160 << 4;
-    int16_t cy = 90 << 4;
+    uint8_t live_mask = worker_active;
+
+    // --- GEOMETRIC PHYSICS ---
+    // Everyone moves first, so guardian checks see this frame's positions
+    for (uint8_t n = 0; n < worker_live_count; n++) {
+        uint8_t i = worker_live[n];
+        update_cached_orbit(&worker_orbits[i], &worker_x[i], &worker_y[i], &worker_angle[i], 
+                            worker_radius[i], worker_eccentricity[i], worker_speed[i], worker_omega[i]);
+    }
 
-    for (int i = 0; i < MAX_WORKERS; i++) {
-        unsigned config_addr = WORKER_CONFIG_BASE + (i * sizeof(vga_mode4_asprite_t));
-        
-        if (!workers[i].active) {
-            xram0_struct_set(config_addr, vga_mode4_asprite_t, y_pos_px, -32);
+    // --- INTERACTION LOGIC ---
+    // GUARDIAN (Cyan): Seek & Destroy Enemies AND Workers
+    // GARDENER (Magenta): Heals the galaxy in galaxy_tick
+    sweep_sort_x(enemy_by_x, MAX_ENEMIES, enemy_x);
+    sweep_sort_x(worker_by_x, MAX_WORKERS, worker_x);
+    for (uint8_t n = 0; n < worker_live_count; n++) {
+        uint8_t i = worker_live[n];
+        if (worker_type[i] != 0) continue;
+        if (!(worker_active & (1 << i))) continue; // Killed earlier this frame
+
+        // Check Enemies
+        uint8_t e = first_hit(enemy_by_x, MAX_ENEMIES, enemy_x, enemy_y, enemy_active, NO_HIT,
+                              worker_x[i], worker_y[i]);
+        if (e != NO_HIT) {
+            // Collision! Destroy Enemy AND Self
+            // EXPLOSION: Red/Gold (Type 1) for Enemy Kill
+            galaxy_explosion((worker_x[i] >> 4), (worker_y[i] >> 4), 1);
+            
+            kill_enemy(e);
+            kill_worker(i); // Kamikaze
             continue;
         }
-
-        // --- GRAVITY PHYSICS ---
-        
-        // Distance to center
-        // --- GEOMETRIC PHYSICS ---
-        update_geometric_orbit(&workers[i].x, &workers[i].y, &workers[i].angle, 
-                               workers[i].radius, workers[i].eccentricity, workers[i].speed, workers[i].omega);
         
+        // Check Other Workers (Friendly Fire / Cleanup)
+        uint8_t w = first_hit(worker_by_x, MAX_WORKERS, worker_x, worker_y, worker_active, i,
+                              worker_x[i], worker_y[i]);
+        if (w != NO_HIT) {
+            // Destroy Worker AND Self
+            // EXPLOSION: Blue (Type 0) for Friendly Fire
+            galaxy_explosion((worker_x[i] >> 4), (worker_y[i] >> 4), 0);
+            
+            kill_worker(w);
+            kill_worker(i); // Kamikaze
+        }
+    }
+
+    for (uint8_t n = 0; n < worker_live_count; n++) {
+        uint8_t i = worker_live[n];
+        if (!(worker_active & (1 << i))) continue; // Died this frame
+
         // Screen Coords (Center of Sprite)
         // Sprite is 16x16. We must draw at Top-Left.
         // x >> 4 gives Center. Subtract 8.
-        int16_t px = ((workers[i].x >> 4) - 8);
-        int16_t py = ((workers[i].y >> 4) - 8);
-        
-        // --- INTERACTION LOGIC ---
-        if (workers[i].type == 0) {
-            // GUARDIAN (Cyan): Seek & Destroy Enemies AND Workers
-            // Check Enemies
-            for (int e = 0; e < MAX_ENEMIES; e++) {
-                if (enemies[e].active) {
-                    if (check_collision(workers[i].x, workers[i].y, enemies[e].x, enemies[e].y)) {
-                        // Collision! Destroy Enemy AND Self
-                        // EXPLOSION: Red/Gold (Type 1) for Enemy Kill
-                        galaxy_explosion((workers[i].x >> 4), (workers[i].y >> 4), 1);
-                        
-                        enemies[e].active = false;
-                        enemies[e].timer = 300; // Respawn Delay (5s)
-                        workers[i].active = false; // Kamikaze
-                        break; // Self died, stop checking
-                    }
-                }
-            }
-            if (!workers[i].active) continue; // Died vs Enemy
-            
-            // Check Other Workers (Friendly Fire / Cleanup)
-            for (int w = 0; w < MAX_WORKERS; w++) {
-                if (w != i && workers[w].active) {
-                    // Destroy Worker AND Self
-                    if (check_collision(workers[i].x, workers[i].y, workers[w].x, workers[w].y)) {
-                        // EXPLOSION: Blue (Type 0) for Friendly Fire
-                        galaxy_explosion((workers[i].x >> 4), (workers[i].y >> 4), 0);
-                        
-                        workers[w].active = false;
-                        workers[i].active = false; // Kamikaze
-                        break; 
-                    }
-                }
-            }
-        } else {
-            // GARDENER (Magenta): Heal Galaxy
-            // Heal pixels at current location
-        }
+        int16_t px = ((worker_x[i] >> 4) - 8);
+        int16_t py = ((worker_y[i] >> 4) - 8);
 
         // Animation
-        workers[i].timer++;
-        if (workers[i].timer > 8) {
-            workers[i].timer = 0;
+        worker_timer[i]++;
+        if (worker_timer[i] > 8) {
+            worker_timer[i] = 0;
             // Toggle Frame: Guardian (0-1), Gardener (2-3)
-            uint8_t base = (workers[i].type == 0) ? 0 : 2;
-            uint8_t offset = (workers[i].frame - base + 1) & 1;
-            workers[i].frame = base + offset;
+            uint8_t base = (worker_type[i] == 0) ? 0 : 2;
+            uint8_t offset = (worker_frame[i] - base + 1) & 1;
+            worker_frame[i] = base + offset;
         }
         
+#ifdef USE_PREROTATED_SPRITES
+        // Render (Plain): one unrotated frame per type
+        unsigned sprite_ptr = WORKER_DATA_ADDR + ((worker_frame[i] >> 1) * 512);
+        sprite_place(worker_sprite[i], px, py, sprite_ptr, 4); // 16x16
+#else
         // Render (Affine)
         // Rotate workers to face velocity? Or spin? 
         // Let's just spin them slowly based on position for now
-        int16_t rot = workers[i].x; 
-        
-        // Optimized Affine (Scale = 256 means 1.0, so A=c, etc.)
-        int16_t c = SIN_LUT[(uint8_t)(rot + 64)]; 
-        int16_t s = SIN_LUT[(uint8_t)rot];
-        
-        int16_t A = c;
-        int16_t B = -s;
-        int16_t C = s;
-        int16_t D = c;
-        
-        // Center 8,8
-        // 8<<8 = 2048. 
-        // A*8 fits in 16-bit (256*8 = 2048).
-        // No 32-bit math needed for simple centering.
-        int16_t TX = 2048 - (A * 8) - (B * 8);
-        int16_t TY = 2048 - (C * 8) - (D * 8);
-        
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[0], A); 
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[1], B);   
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[2], TX);   
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[3], C);   
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[4], D); 
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[5], TY);   
-        
-        unsigned sprite_ptr = WORKER_DATA_ADDR + (workers[i].frame * 512);
-
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, x_pos_px, px);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, y_pos_px, py);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, xram_sprite_ptr, sprite_ptr);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, log_size, 4); // 16x16
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, has_opacity_metadata, false);
+        sprite_place_rotated(worker_sprite[i], px, py, WORKER_DATA_ADDR + (worker_frame[i] * 512),
+                             4, (uint8_t)worker_x[i]); // 16x16
+#endif
     }
+
+    if (worker_active != live_mask) workers_relist();
 }
 
 void spawn_enemy(int16_t x, int16_t y) {
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        if (!enemies[i].active) {
-            enemies[i].active = true;
+    for (uint8_t i = 0; i < MAX_ENEMIES; i++) {
+        if (!(enemy_active & (1 << i))) {
+            enemy_active |= (1 << i);
+            enemy_respawn &= ~(1 << i);
+            enemy_sprite[i] = sprite_request(ENEMY_SPRITE_PRIO);
             
             int16_t cx = 160;
             int16_t cy = 90;
@@ -259,128 +295,86 @@ void spawn_enemy(int16_t x, int16_t y) {
             int16_t dy = y - cy;
             
             // Freeze Eccentricity
-            enemies[i].eccentricity = current_eccentricity;
+            enemy_eccentricity[i] = current_eccentricity;
             
             // Apocenter Spawn Logic
-            uint8_t phi = vector_to_angle(dx, dy);
-            enemies[i].omega = phi + 128;
-            enemies[i].angle = 128 << 8;
-            
-            // Distance
-            int16_t adx = (dx < 0) ? -dx : dx;
-            int16_t ady = (dy < 0) ? -dy : dy;
-            int16_t r = (adx > ady) ? adx + ady/2 : ady + adx/2;
-            
-            // a = r / (1+e)
-            uint16_t denom = 256 + enemies[i].eccentricity;
-            int32_t num = (int32_t)r * 256;
-            int16_t a_val = (int16_t)(num / denom);
-            
-            if (a_val > 85) a_val = 85; 
-            if (a_val < 30) a_val = 30; 
-            
-            enemies[i].radius = (uint8_t)a_val;
+            solve_apocenter_orbit(dx, dy, enemy_eccentricity[i], 30,
+                                  &enemy_omega[i], &enemy_angle[i],
+                                  &enemy_radius[i], &enemy_speed[i]);
             
-            // Speed
-            uint16_t calc_speed = 3500 / enemies[i].radius;
-            if (calc_speed > 255) calc_speed = 255;
-            if (calc_speed < 20) calc_speed = 20;
-            enemies[i].speed = (uint8_t)calc_speed;
+            orbit_cache_reset(&enemy_orbits[i]);
+            update_cached_orbit(&enemy_orbits[i], &enemy_x[i], &enemy_y[i], &enemy_angle[i], 
+                                enemy_radius[i], current_eccentricity, enemy_speed[i], enemy_omega[i]);
             
-            update_geometric_orbit(&enemies[i].x, &enemies[i].y, &enemies[i].angle, 
-                                   enemies[i].radius, current_eccentricity, enemies[i].speed, enemies[i].omega);
-            
-            enemies[i].timer = 0;
-            enemies[i].frame = 0;
+            enemy_timer[i] = 0;
+            enemy_frame[i] = 0;
+            enemies_relist();
             return;
         }
     }
 }
 
-// Squared distance check for collision (16x16 sprites, radius ~8)
-// Threshold: (8+8)^2 = 256. Let's use 16*16 = 256.
-
+// Dead enemy i counts its respawn delay down; at 1 it comes back at a
+// random spot. Returns true on respawn.
+static bool respawn_enemy(uint8_t i) {
+    enemy_timer[i]--;
+    if (enemy_timer[i] != 1) return false;
+
+    // RESPAWN!
+    // Reset to active
+    enemy_active |= (1 << i);
+    enemy_respawn &= ~(1 << i);
+    enemy_timer[i] = 0;
+    enemy_sprite[i] = sprite_request(ENEMY_SPRITE_PRIO);
+    
+    // Pick Random Location (80..240, 10..170)
+    // Box 160x160 centered.
+    // Low byte of rand() scaled to 0..159 (no modulo divide)
+    int16_t rx = (((uint16_t)(rand() & 0xFF) * 160) >> 8) + 80; 
+    int16_t ry = (((uint16_t)(rand() & 0xFF) * 160) >> 8) + 10;
+    
+    // Logic from spawn_enemy inline to avoid searching loop
+    int16_t cx = 160;
+    int16_t cy = 90;
+    int16_t dx = rx - cx;
+    int16_t dy = ry - cy;
+    
+    // Random Eccentricity (Cap at 64 = 0.25)
+    // User suspects high e causes issues.
+    enemy_eccentricity[i] = (uint8_t)(rand() & 63);
+    
+    solve_apocenter_orbit(dx, dy, enemy_eccentricity[i], 30,
+                          &enemy_omega[i], &enemy_angle[i],
+                          &enemy_radius[i], &enemy_speed[i]);
+    
+    // Initial Pos
+    orbit_cache_reset(&enemy_orbits[i]);
+    update_cached_orbit(&enemy_orbits[i], &enemy_x[i], &enemy_y[i], &enemy_angle[i], 
+                        enemy_radius[i], enemy_eccentricity[i], enemy_speed[i], enemy_omega[i]);
+    return true;
+}
 
 void update_enemies(void) {
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        unsigned config_addr = ENEMY_CONFIG_BASE + (i * sizeof(vga_mode4_asprite_t)); // NOW AFFINE STRUCT
-        
-        if (!enemies[i].active) {
-            // Respawn Logic
-            if (enemies[i].timer > 0) {
-                enemies[i].timer--;
-                if (enemies[i].timer == 1) {
-                    // RESPAWN!
-                    // Reset to active
-                    enemies[i].active = true;
-                    enemies[i].timer = 0;
-                    
-                    // Pick Random Location (80..240, 10..170)
-                    // Box 160x160 centered.
-                    // Sanitize rand()
-                    int16_t rx = (abs(rand()) % 160) + 80; 
-                    int16_t ry = (abs(rand()) % 160) + 10;
-                    
-                    // Logic from spawn_enemy inline to avoid searching loop
-                    int16_t cx = 160;
-                    int16_t cy = 90;
-                    int16_t dx = rx - cx;
-                    int16_t dy = ry - cy;
-                    
-                    // Random Eccentricity (Cap at 64 = 0.25)
-                    // User suspects high e causes issues.
-                    enemies[i].eccentricity = (uint8_t)(abs(rand()) % 64);
-                    
-                    uint8_t phi = vector_to_angle(dx, dy);
-                    enemies[i].omega = phi + 128;
-                    enemies[i].angle = 128 << 8;
-                    
-                    int16_t adx = (dx < 0) ? -dx : dx;
-                    int16_t ady = (dy < 0) ? -dy : dy;
-                    int16_t r = (adx > ady) ? adx + ady/2 : ady + adx/2;
-                    
-                    uint16_t denom = 256 + enemies[i].eccentricity;
-                    int32_t num = (int32_t)r * 256;
-                    int16_t a_val = (int16_t)(num / denom);
-                    
-                    if (a_val > 85) a_val = 85; 
-                    if (a_val < 30) a_val = 30; 
-                    
-                    enemies[i].radius = (uint8_t)a_val;
-                    
-                    uint16_t calc_speed = 3500 / enemies[i].radius;
-                    if (calc_speed > 255) calc_speed = 255;
-                    if (calc_speed < 20) calc_speed = 20;
-                    enemies[i].speed = (uint8_t)calc_speed;
-                    
-                    // Initial Pos
-                    update_geometric_orbit(&enemies[i].x, &enemies[i].y, &enemies[i].angle, 
-                                           enemies[i].radius, enemies[i].eccentricity, enemies[i].speed, enemies[i].omega);
-                 }
-            } else {
-                // Move offscreen if purely inactive
-                xram0_struct_set(config_addr, vga_mode4_asprite_t, y_pos_px, -32);
-            }
-            continue;
-        }
+    for (uint8_t n = 0; n < enemy_live_count; n++) {
+        uint8_t i = enemy_live[n];
 
         // --- GEOMETRIC PHYSICS ---
-        int16_t old_x = enemies[i].x;
-        int16_t old_y = enemies[i].y;
+        int16_t old_x = enemy_x[i];
+        int16_t old_y = enemy_y[i];
         
-        update_geometric_orbit(&enemies[i].x, &enemies[i].y, &enemies[i].angle, 
-                               enemies[i].radius, enemies[i].eccentricity, enemies[i].speed, enemies[i].omega);
+        update_cached_orbit(&enemy_orbits[i], &enemy_x[i], &enemy_y[i], &enemy_angle[i], 
+                            enemy_radius[i], enemy_eccentricity[i], enemy_speed[i], enemy_omega[i]);
 
         // Directional Rotation Logic
-        int16_t dx = enemies[i].x - old_x; // 12.4 fixed point
-        int16_t dy = enemies[i].y - old_y;
+        int16_t dx = enemy_x[i] - old_x; // 12.4 fixed point
+        int16_t dy = enemy_y[i] - old_y;
         
         if (abs(dx) > 4 || abs(dy) > 4) { // Threshold > 0.25 px movement
              uint8_t move_angle = vector_to_angle(dx, dy);
              
              // SMOOTHING (Low Pass Filter)
              // Create signed difference (-128 to +127) handling wrap-around
-             int8_t diff = (int8_t)(move_angle - enemies[i].visual_angle);
+             int8_t diff = (int8_t)(move_angle - enemy_visual_angle[i]);
              
              // Move 1/4 of the way (Shift 2)
              int8_t step = diff / 4;
@@ -390,59 +384,55 @@ void update_enemies(void) {
                  step = (diff > 0) ? 1 : -1;
              }
              
-             enemies[i].visual_angle += step;
+             enemy_visual_angle[i] += step;
         }
         
 
         
         // Logic: Rotate based on velocity? Or just spin?
         // Let's spin for now by using the orbital angle (Tidal Locking)
-        // enemies[i].angle += 2; // REMOVED: This confounds the orbital position!
+        // enemy_angle[i] += 2; // REMOVED: This confounds the orbital position!
 
         // Animation
-        enemies[i].timer++;
-        if (enemies[i].timer > 8) { // Animation Speed
-            enemies[i].timer = 0;
-            enemies[i].frame = (enemies[i].frame + 1) & 3; // Cycle 0-3
+        enemy_timer[i]++;
+        if (enemy_timer[i] > 8) { // Animation Speed
+            enemy_timer[i] = 0;
+            enemy_frame[i] = (enemy_frame[i] + 1) & 3; // Cycle 0-3
         }
         
+        // CONVERT BACK TO PIXELS (>> 4)
+        // Physics returns Center. Sprite needs Top-Left. 16x16 -> -8.
+        int16_t px = ((enemy_x[i] >> 4) - 8);
+        int16_t py = ((enemy_y[i] >> 4) - 8);
+
+#ifdef USE_PREROTATED_SPRITES
+        // Render - Nearest Baked Heading
+        // Atlas heading 0 faces up (visual_angle 192), headings run clockwise.
+        // +64 turns visual_angle into that frame, +128 rounds to nearest.
+        uint8_t heading = (uint8_t)(((uint16_t)(uint8_t)(enemy_visual_angle[i] + 64) * SPRITE_HEADINGS + 128) >> 8);
+        if (heading >= SPRITE_HEADINGS) heading = 0;
+
+        unsigned sprite_ptr = ENEMY_DATA_ADDR + (heading * 512);
+        sprite_place(enemy_sprite[i], px, py, sprite_ptr, 4); // 16x16
+#else
         // Render - Affine Calculation
         // DIRECTIONAL ROTATION
         // Reflection Fix: Output = 192 - Input (Corrects for Screen=192-Affine)
-        uint8_t angle = 192 - enemies[i].visual_angle;
-        
-        int16_t c = SIN_LUT[(uint8_t)(angle + 64)]; // cos
-        int16_t s = SIN_LUT[angle]; // sin
-        
-        // Optimized Affine (Scale = 256)
-        int16_t A = c; 
-        int16_t B = -s;
-        int16_t C = s;
-        int16_t D = c;
-
-        // Centering Logic (16x16) means center is 8,8.
-        // Wait, line 423 says cx=8, cy=8. 
-        // 8<<8 = 2048.
-        int16_t TX = 2048 - (A * 8) - (B * 8);
-        int16_t TY = 2048 - (C * 8) - (D * 8);
-
-        unsigned sprite_ptr = ENEMY_DATA_ADDR + (enemies[i].frame * 512);
-
-        // Update Affine Struct
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[0], A);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[1], B);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[2], TX);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[3], C); 
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[4], D); 
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, transform[5], TY);
-        
-        // CONVERT BACK TO PIXELS (>> 4)
-        // Physics returns Center. Sprite needs Top-Left. 16x16 -> -8.
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, x_pos_px, ((enemies[i].x >> 4) - 8));
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, y_pos_px, ((enemies[i].y >> 4) - 8));
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, xram_sprite_ptr, sprite_ptr);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, log_size, 4); // 16x16
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, has_opacity_metadata, false);
+        uint8_t angle = 192 - enemy_visual_angle[i];
+
+        unsigned sprite_ptr = ENEMY_DATA_ADDR + (enemy_frame[i] * 512);
+        sprite_place_rotated(enemy_sprite[i], px, py, sprite_ptr, 4, angle); // 16x16
+#endif
+    }
+
+    // Respawn timers run after the live pass, so a returning enemy first
+    // moves next frame
+    if (enemy_respawn) {
+        bool respawned = false;
+        for (uint8_t i = 0; i < MAX_ENEMIES; i++) {
+            if ((enemy_respawn & (1 << i)) && respawn_enemy(i)) respawned = true;
+        }
+        if (respawned) enemies_relist();
     }
 }
 
@@ -467,37 +457,17 @@ void init_sprites(void)
     xram0_struct_set(SPRITE_CONFIG_ADDR, vga_mode4_asprite_t, log_size, 5); // 32x32 = 2^5
     xram0_struct_set(SPRITE_CONFIG_ADDR, vga_mode4_asprite_t, has_opacity_metadata, false);
 
-    // Enable Plane 2 for Reticle (Mode 4 Affine)
-    xregn(1, 0, 1, 5, 4, 1, SPRITE_CONFIG_ADDR, 1, 2); 
-
-    // --- PLANE 1: ENEMIES (Mode 4 AFFINE) ---
-    // Initialize Enemy Configs - Need valid data initially or they might glitch
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        unsigned config_addr = ENEMY_CONFIG_BASE + (i * sizeof(vga_mode4_asprite_t)); // SIZE changed
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, x_pos_px, -32); // Offscreen
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, y_pos_px, -32);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, xram_sprite_ptr, ENEMY_DATA_ADDR);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, log_size, 4); // 16x16 = 2^4
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, has_opacity_metadata, false);
+    // Enemies and workers get configs from the multiplexer, which also
+    // enables plane 1 (plain pool) and plane 2 (affine pool + reticle)
+    for (uint8_t i = 0; i < MAX_ENEMIES; i++) {
+        enemy_by_x[i] = i;
+        enemy_sprite[i] = SPRITE_NO_HANDLE;
     }
-
-    // Initialize Worker Configs
-    for (int i = 0; i < MAX_WORKERS; i++) {
-        unsigned config_addr = WORKER_CONFIG_BASE + (i * sizeof(vga_mode4_asprite_t));
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, x_pos_px, -32); // Offscreen
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, y_pos_px, -32);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, xram_sprite_ptr, WORKER_DATA_ADDR);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, log_size, 4);
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, has_opacity_metadata, false);
+    for (uint8_t i = 0; i < MAX_WORKERS; i++) {
+        worker_by_x[i] = i;
+        worker_sprite[i] = SPRITE_NO_HANDLE;
     }
-
-    // Enable Plane 1 (Enemies AND Workers)
-    // Reg 1: Mode = 4
-    // Reg 2: Options = 1 (Affine Enabled)
-    // Reg 3: Config_Ptr = ENEMY_CONFIG_BASE (Start of block)
-    // Reg 4: Length = MAX_ENEMIES + MAX_WORKERS
-    // Reg 5: Plane = 1
-    xregn(1, 0, 1, 5, 4, 1, ENEMY_CONFIG_BASE, MAX_ENEMIES + MAX_WORKERS, 1);
+    sprite_mux_init();
     
     spawn_enemy(50, 50);
     spawn_enemy(270, 130);
@@ -515,6 +485,15 @@ void update_reticle_position(int8_t dx, int8_t dy) {
     if (reticle_y > 180-16) reticle_y = 180-16;
 }
 
+// (scale * v) >> 8 with arithmetic-shift rounding, for 8.8 scale and a
+// SIN_LUT value. |v| == 256 is the only case past 8 bits.
+static int16_t scale_q8(uint16_t scale, int16_t v) {
+    uint16_t mag = (v < 0) ? -v : v;
+    uint32_t p = (mag > 255) ? ((uint32_t)scale << 8) : umul16x8(scale, (uint8_t)mag);
+    if (v >= 0) return (int16_t)(p >> 8);
+    return -(int16_t)((p + 255) >> 8); // floor, as >> on a negative product
+}
+
 void update_sprites(void)
 {
     sprite_angle += 1; // 1 degree per frame (256 = 360 approx)
@@ -560,10 +539,10 @@ void update_sprites(void)
     // SIN_LUT is 1.0 amplitude (256). Scale is 256 (1.0).
     // result = (scale * sin) >> 8
     
-    int16_t A = ((int32_t)scale * c) >> 8; 
-    int16_t B = ((int32_t)scale * (-s)) >> 8;
-    int16_t C = ((int32_t)scale * s) >> 8;
-    int16_t D = ((int32_t)scale * c) >> 8;
+    int16_t A = scale_q8(scale, c); 
+    int16_t B = scale_q8(scale, -s);
+    int16_t C = scale_q8(scale, s);
+    int16_t D = A;
 
     // Centering Logic
     // Screen Position: Top-Left at (reticle_x, reticle_y).
@@ -595,19 +574,22 @@ void update_sprites(void)
 
 void reset_sprites(void) {
     // Clear Enemies
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        enemies[i].active = false;
-        // Update struct to hide them immediately
-        unsigned config_addr = ENEMY_CONFIG_BASE + (i * sizeof(vga_mode4_asprite_t));
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, y_pos_px, -32);
+    // Pending respawn timers keep running
+    enemy_active = 0;
+    for (uint8_t i = 0; i < MAX_ENEMIES; i++) {
+        // Unplaced sprites are parked at the next commit
+        sprite_release(enemy_sprite[i]);
+        enemy_sprite[i] = SPRITE_NO_HANDLE;
     }
     
     // Clear Workers
-    for (int i = 0; i < MAX_WORKERS; i++) {
-        workers[i].active = false;
-        unsigned config_addr = WORKER_CONFIG_BASE + (i * sizeof(vga_mode4_asprite_t));
-        xram0_struct_set(config_addr, vga_mode4_asprite_t, y_pos_px, -32);
+    worker_active = 0;
+    for (uint8_t i = 0; i < MAX_WORKERS; i++) {
+        sprite_release(worker_sprite[i]);
+        worker_sprite[i] = SPRITE_NO_HANDLE;
     }
+    enemies_relist();
+    workers_relist();
     
     // Respawn Initials
     spawn_enemy(50, 50);
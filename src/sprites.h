@@ -4,38 +4,34 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-typedef struct {
-    bool active;
-    int16_t x, y;   // 12.4 Fixed Point
-    uint16_t angle; // 8.8 Fixed Point (0-255 integer part)
-    uint8_t omega;  // Argument of Periapsis (Orientation)
-    uint8_t radius; // Semi-major axis (pixels)
-    uint8_t eccentricity; // Orbital Eccentricity (0-255, usually 0-128)
-    uint8_t speed;  // Base orbital speed (8.8)
-    int16_t timer;
-    uint8_t frame;
-    uint8_t visual_angle; // For directional rotation
-} enemy_t;
-
 #define MAX_ENEMIES 8
-
-typedef struct {
-    bool active;
-    int16_t x, y;   // 12.4 Fixed Point
-    uint8_t type;   // 0=Guardian (Cyan), 1=Gardener (Magenta)
-    uint16_t angle; // 8.8 Fixed Point
-    uint8_t omega;  // Argument of Periapsis
-    uint8_t radius; // Semi-major axis (pixels)
-    uint8_t eccentricity; // Orbital Eccentricity
-    uint8_t speed;  // Base orbital speed
-    int16_t timer;
-    uint8_t frame;
-} worker_t;
-
 #define MAX_WORKERS 8
 
-extern enemy_t enemies[MAX_ENEMIES];
-extern worker_t workers[MAX_WORKERS];
+// Entity storage is struct-of-arrays, field[slot] for slots 0..7, so hot
+// loops index every field with one 8-bit register. A slot is live when its
+// bit is set in the active mask. The live lists hold the live slots in
+// ascending order and are rebuilt only when a slot is spawned or killed;
+// galaxy_tick and the sprite updates walk those instead of all 8 slots.
+// Per-entity orbit and animation fields stay private to sprites.c.
+#if MAX_ENEMIES > 8 || MAX_WORKERS > 8
+#error "Entity active masks are one byte"
+#endif
+
+// Enemies
+extern int16_t enemy_x[MAX_ENEMIES], enemy_y[MAX_ENEMIES]; // 12.4 Fixed Point
+extern uint8_t enemy_active;              // Bit e set: enemy e is live
+extern uint8_t enemy_live[MAX_ENEMIES];   // Live slots, ascending
+extern uint8_t enemy_live_count;
+
+// Workers
+extern int16_t worker_x[MAX_WORKERS], worker_y[MAX_WORKERS]; // 12.4 Fixed Point
+extern uint8_t worker_type[MAX_WORKERS];  // 0=Guardian (Cyan), 1=Gardener (Magenta)
+extern uint8_t worker_active;             // Bit w set: worker w is live
+extern uint8_t worker_live[MAX_WORKERS];  // Live slots, ascending
+extern uint8_t worker_live_count;
+extern uint8_t gardener_live[MAX_WORKERS]; // Live type 1 slots, ascending
+extern uint8_t gardener_count;
+
 extern int16_t reticle_x, reticle_y;
 
 void init_sprites(void);
@@ -0,0 +1,55 @@
+#ifndef XRAM_H
+#define XRAM_H
+
+#include <rp6502.h>
+#include <stdint.h>
+
+// Unrolled XRAM block operations (xram.s).
+// Cycle counts are per KB processed, loop overhead included.
+
+// Write len bytes of value from addr through portal 0.        ~4.5k / KB
+void xram_fill(uint16_t addr, uint16_t len, uint8_t value);
+
+// XRAM to XRAM: read src through portal 0, write dst through
+// portal 1. Overlap is only safe with dst below src.           ~8.9k / KB
+void xram_copy(uint16_t dst, uint16_t src, uint16_t len);
+
+// RAM to XRAM through portal 0 (palettes, configs).           ~11.8k / KB
+void xram_upload(uint16_t addr, const void *src, uint16_t len);
+
+// Halve both 4-bit channels of count bytes at addr, addr + 2, ...
+// Reads stream through portal 0 and writes through portal 1.  ~13k / KB
+void xram_decay2(uint16_t addr, uint16_t count);
+
+// Same for the 4bpp bitmap: halve the four 2-bit channels.  ~13k / KB
+void xram_decay2_4bpp(uint16_t addr, uint16_t count);
+
+// Pixel-doubled decay: halve count bytes at src, src + 2, ... and write
+// each result twice, to dst, dst + 1, ... In place is fine.  ~17k / KB read
+void xram_decay2x(uint16_t dst, uint16_t src, uint16_t count);
+
+// Unpack an LZ stream (tools/lz_pack.py, no header) at src to dst: reads
+// through portal 1, writes through portal 0.          ~14k / KB unpacked
+void xram_unlz(uint16_t dst, uint16_t src);
+
+// Portal 1 is the write stream for decay and the galaxy splat. Anything
+// else that borrows it (opl_write) saves it first and restores it after,
+// so a stream is never left pointing somewhere else.
+typedef struct {
+    uint16_t addr;
+    int8_t step;
+} xram_portal_t;
+
+static inline void xram_portal1_save(xram_portal_t *p)
+{
+    p->addr = RIA.addr1;
+    p->step = RIA.step1;
+}
+
+static inline void xram_portal1_restore(const xram_portal_t *p)
+{
+    RIA.step1 = p->step;
+    RIA.addr1 = p->addr;
+}
+
+#endif // XRAM_H
@@ -0,0 +1,377 @@
+; xram.s - unrolled XRAM block operations
+;
+; C prototypes and per-KB costs are in xram.h. Arguments follow the
+; llvm-mos calling convention: argument bytes fill A, X, then __rc2
+; upward. So the first 16-bit argument is in A (lo) / X (hi), the second
+; in __rc2/__rc3, and the third in __rc4/__rc5. All of these are
+; caller-saved, so the routines use them freely as scratch.
+;
+; Each routine leaves the portal(s) it used pointing just past its last
+; access, with the step it set.
+
+.set RIA_RW0,   0xFFE4
+.set RIA_STEP0, 0xFFE5
+.set RIA_ADDR0, 0xFFE6
+.set RIA_RW1,   0xFFE8
+.set RIA_STEP1, 0xFFE9
+.set RIA_ADDR1, 0xFFEA
+
+; void xram_fill(uint16_t addr, uint16_t len, uint8_t value)
+;   A/X = addr, __rc2/3 = len, __rc4 = value
+.section .text.xram_fill,"ax",@progbits
+.globl xram_fill
+xram_fill:
+    sta RIA_ADDR0
+    stx RIA_ADDR0+1
+    lda #1
+    sta RIA_STEP0
+    lda mos8(__rc2)
+    and #15
+    sta mos8(__rc5)            ; tail bytes
+    lsr mos8(__rc3)            ; __rc3:__rc2 = 16-byte blocks
+    ror mos8(__rc2)
+    lsr mos8(__rc3)
+    ror mos8(__rc2)
+    lsr mos8(__rc3)
+    ror mos8(__rc2)
+    lsr mos8(__rc3)
+    ror mos8(__rc2)
+    ldx mos8(__rc2)
+    beq 1f
+    inc mos8(__rc3)            ; partial first round of X
+1:
+    ldy mos8(__rc3)
+    beq .Lfill_tail
+    lda mos8(__rc4)
+.Lfill_block:
+    .rept 16
+    sta RIA_RW0
+    .endr
+    dex
+    bne .Lfill_block
+    dey
+    bne .Lfill_block
+.Lfill_tail:
+    ldx mos8(__rc5)
+    beq .Lfill_done
+    lda mos8(__rc4)
+.Lfill_byte:
+    sta RIA_RW0
+    dex
+    bne .Lfill_byte
+.Lfill_done:
+    rts
+
+; void xram_copy(uint16_t dst, uint16_t src, uint16_t len)
+;   A/X = dst (portal 1), __rc2/3 = src (portal 0), __rc4/5 = len
+.section .text.xram_copy,"ax",@progbits
+.globl xram_copy
+xram_copy:
+    sta RIA_ADDR1
+    stx RIA_ADDR1+1
+    lda mos8(__rc2)
+    sta RIA_ADDR0
+    lda mos8(__rc3)
+    sta RIA_ADDR0+1
+    lda #1
+    sta RIA_STEP0
+    sta RIA_STEP1
+    lda mos8(__rc4)
+    and #7
+    sta mos8(__rc2)            ; tail bytes
+    lsr mos8(__rc5)            ; __rc5:__rc4 = 8-byte blocks
+    ror mos8(__rc4)
+    lsr mos8(__rc5)
+    ror mos8(__rc4)
+    lsr mos8(__rc5)
+    ror mos8(__rc4)
+    ldx mos8(__rc4)
+    beq 1f
+    inc mos8(__rc5)
+1:
+    ldy mos8(__rc5)
+    beq .Lcopy_tail
+.Lcopy_block:
+    .rept 8
+    lda RIA_RW0
+    sta RIA_RW1
+    .endr
+    dex
+    bne .Lcopy_block
+    dey
+    bne .Lcopy_block
+.Lcopy_tail:
+    ldx mos8(__rc2)
+    beq .Lcopy_done
+.Lcopy_byte:
+    lda RIA_RW0
+    sta RIA_RW1
+    dex
+    bne .Lcopy_byte
+.Lcopy_done:
+    rts
+
+; void xram_upload(uint16_t addr, const void *src, uint16_t len)
+;   A/X = addr, __rc2/3 = src, __rc4/5 = len
+.section .text.xram_upload,"ax",@progbits
+.globl xram_upload
+xram_upload:
+    sta RIA_ADDR0
+    stx RIA_ADDR0+1
+    lda #1
+    sta RIA_STEP0
+    ldy #0
+    ldx mos8(__rc5)            ; whole pages
+    beq .Lupload_tail
+.Lupload_page:
+    .rept 8
+    lda (mos8(__rc2)),y
+    sta RIA_RW0
+    iny
+    .endr
+    bne .Lupload_page
+    inc mos8(__rc3)
+    dex
+    bne .Lupload_page
+.Lupload_tail:
+    ldx mos8(__rc4)
+    beq .Lupload_done
+.Lupload_byte:
+    lda (mos8(__rc2)),y
+    sta RIA_RW0
+    iny
+    dex
+    bne .Lupload_byte
+.Lupload_done:
+    rts
+
+; void xram_decay2(uint16_t addr, uint16_t count)
+;   A/X = addr, __rc2/3 = count
+; Halves both nibbles of count bytes at addr, addr + 2, addr + 4, ...
+; Portal 0 is the read stream and portal 1 the write stream, both at
+; step 2, so there is no rewind and no branch per byte.
+.section .text.xram_decay2,"ax",@progbits
+.globl xram_decay2
+xram_decay2:
+    sta RIA_ADDR0
+    stx RIA_ADDR0+1
+    sta RIA_ADDR1
+    stx RIA_ADDR1+1
+    lda #2
+    sta RIA_STEP0
+    sta RIA_STEP1
+    lda mos8(__rc2)
+    and #7
+    sta mos8(__rc4)            ; tail bytes
+    lsr mos8(__rc3)            ; __rc3:__rc2 = 8-byte blocks
+    ror mos8(__rc2)
+    lsr mos8(__rc3)
+    ror mos8(__rc2)
+    lsr mos8(__rc3)
+    ror mos8(__rc2)
+    ldx mos8(__rc2)
+    beq 1f
+    inc mos8(__rc3)
+1:
+    ldy mos8(__rc3)
+    beq .Ldecay_tail
+.Ldecay_block:
+    .rept 8
+    lda RIA_RW0
+    lsr
+    and #0x77
+    sta RIA_RW1
+    .endr
+    dex
+    bne .Ldecay_block
+    dey
+    bne .Ldecay_block
+.Ldecay_tail:
+    ldx mos8(__rc4)
+    beq .Ldecay_done
+.Ldecay_byte:
+    lda RIA_RW0
+    lsr
+    and #0x77
+    sta RIA_RW1
+    dex
+    bne .Ldecay_byte
+.Ldecay_done:
+    rts
+
+; void xram_decay2_4bpp(uint16_t addr, uint16_t count)
+;   A/X = addr, __rc2/3 = count
+; xram_decay2 for the 4bpp bitmap: each byte holds two pixels of 2-bit
+; pink and 2-bit cyan, so all four fields are halved.
+.section .text.xram_decay2_4bpp,"ax",@progbits
+.globl xram_decay2_4bpp
+xram_decay2_4bpp:
+    sta RIA_ADDR0
+    stx RIA_ADDR0+1
+    sta RIA_ADDR1
+    stx RIA_ADDR1+1
+    lda #2
+    sta RIA_STEP0
+    sta RIA_STEP1
+    lda mos8(__rc2)
+    and #7
+    sta mos8(__rc4)            ; tail bytes
+    lsr mos8(__rc3)            ; __rc3:__rc2 = 8-byte blocks
+    ror mos8(__rc2)
+    lsr mos8(__rc3)
+    ror mos8(__rc2)
+    lsr mos8(__rc3)
+    ror mos8(__rc2)
+    ldx mos8(__rc2)
+    beq 1f
+    inc mos8(__rc3)
+1:
+    ldy mos8(__rc3)
+    beq .Ldecay4_tail
+.Ldecay4_block:
+    .rept 8
+    lda RIA_RW0
+    lsr
+    and #0x55
+    sta RIA_RW1
+    .endr
+    dex
+    bne .Ldecay4_block
+    dey
+    bne .Ldecay4_block
+.Ldecay4_tail:
+    ldx mos8(__rc4)
+    beq .Ldecay4_done
+.Ldecay4_byte:
+    lda RIA_RW0
+    lsr
+    and #0x55
+    sta RIA_RW1
+    dex
+    bne .Ldecay4_byte
+.Ldecay4_done:
+    rts
+
+; void xram_decay2x(uint16_t dst, uint16_t src, uint16_t count)
+;   A/X = dst (portal 1), __rc2/3 = src (portal 0), __rc4/5 = count
+; Pixel-doubled decay: halves both nibbles of count bytes at src, src + 2,
+; src + 4, ... and writes each result twice, to dst, dst + 1, ... Running
+; it in place (dst == src) is safe, as every read is ahead of the writes.
+.section .text.xram_decay2x,"ax",@progbits
+.globl xram_decay2x
+xram_decay2x:
+    sta RIA_ADDR1
+    stx RIA_ADDR1+1
+    lda mos8(__rc2)
+    sta RIA_ADDR0
+    lda mos8(__rc3)
+    sta RIA_ADDR0+1
+    lda #2
+    sta RIA_STEP0
+    lda #1
+    sta RIA_STEP1
+    lda mos8(__rc4)
+    and #7
+    sta mos8(__rc2)            ; tail bytes
+    lsr mos8(__rc5)            ; __rc5:__rc4 = 8-byte blocks
+    ror mos8(__rc4)
+    lsr mos8(__rc5)
+    ror mos8(__rc4)
+    lsr mos8(__rc5)
+    ror mos8(__rc4)
+    ldx mos8(__rc4)
+    beq 1f
+    inc mos8(__rc5)
+1:
+    ldy mos8(__rc5)
+    beq .Ldecay2x_tail
+.Ldecay2x_block:
+    .rept 8
+    lda RIA_RW0
+    lsr
+    and #0x77
+    sta RIA_RW1
+    sta RIA_RW1
+    .endr
+    dex
+    bne .Ldecay2x_block
+    dey
+    bne .Ldecay2x_block
+.Ldecay2x_tail:
+    ldx mos8(__rc2)
+    beq .Ldecay2x_done
+.Ldecay2x_byte:
+    lda RIA_RW0
+    lsr
+    and #0x77
+    sta RIA_RW1
+    sta RIA_RW1
+    dex
+    bne .Ldecay2x_byte
+.Ldecay2x_done:
+    rts
+
+; void xram_unlz(uint16_t dst, uint16_t src)
+;   A/X = dst (portal 0), __rc2/3 = src (portal 1)
+; Unpacks an LZ stream (tools/lz_pack.py, header already stripped) from
+; src to dst, until the end token. Literals stream portal 1 to portal 0;
+; a match parks portal 1 at dst - offset for the copy, then puts it back
+; on the stream. lz_pack.py never emits a match that overlaps its own
+; output (offset < length): decoding one relies on a write through portal
+; 0 refreshing RW1 when portal 1 points at the same address, which is not
+; confirmed on hardware (see OVERLAP there).
+.section .text.xram_unlz,"ax",@progbits
+.globl xram_unlz
+xram_unlz:
+    sta RIA_ADDR0
+    stx RIA_ADDR0+1
+    lda mos8(__rc2)
+    sta RIA_ADDR1
+    lda mos8(__rc3)
+    sta RIA_ADDR1+1
+    lda #1
+    sta RIA_STEP0
+    sta RIA_STEP1
+.Lunlz_token:
+    ldx RIA_RW1
+    beq .Lunlz_done            ; 0x00: end
+    bmi .Lunlz_match
+.Lunlz_literal:                ; 0x01-0x7F: X literal bytes
+    lda RIA_RW1
+    sta RIA_RW0
+    dex
+    bne .Lunlz_literal
+    beq .Lunlz_token
+.Lunlz_match:                  ; 0x80-0xFF: (X & 0x7F) + 4 bytes from offset
+    txa
+    and #0x7F
+    clc
+    adc #4
+    tax
+    sec
+    lda RIA_ADDR0              ; __rc5:__rc4 = dst - offset
+    sbc RIA_RW1
+    sta mos8(__rc4)
+    lda RIA_ADDR0+1
+    sbc RIA_RW1
+    sta mos8(__rc5)
+    lda RIA_ADDR1              ; Park the stream
+    sta mos8(__rc2)
+    lda RIA_ADDR1+1
+    sta mos8(__rc3)
+    lda mos8(__rc4)
+    sta RIA_ADDR1
+    lda mos8(__rc5)
+    sta RIA_ADDR1+1
+.Lunlz_copy:
+    lda RIA_RW1
+    sta RIA_RW0
+    dex
+    bne .Lunlz_copy
+    lda mos8(__rc2)            ; Back to the stream
+    sta RIA_ADDR1
+    lda mos8(__rc3)
+    sta RIA_ADDR1+1
+    jmp .Lunlz_token
+.Lunlz_done:
+    rts
@@ -0,0 +1,125 @@
+#!/usr/bin/env python3
+"""
+Cycles at each quarter-square multiply call site, before and after,
+on the W65C02S core in tools/sim6502 (needs a host C++ compiler, $CXX).
+
+  safe_mul_shift   physics.c      16x16 __mulhi3       -> umul16x8
+  attractor index  galaxy.c       int32 __mulsi3       -> smul16x8
+  splat addressing galaxy.c       9x __mulhi3 / patch  -> 1x umul16x8
+  reticle affine   sprites.c      4x int32 __mulsi3    -> 3x scale_q8
+  check_collision  sprites.c      2x 16x16 __mulhi3    -> box test, 2x umul8x8
+
+No llvm-mos compiler is available here, so each site is hand-assembled
+both ways in tools/sim6502/bench/multiply.s, the old multiplies going
+through models of the runtime helpers (bench/runtime.s). The models skip
+the __rc argument shuffle, which makes "before" low. They are also called
+for constant factors (RAD_SCALE, SCREEN_WIDTH), where llvm-mos may emit
+shifts and adds instead, which makes "before" high at the index and splat
+sites. Every result is checked against the Python models below before it
+is timed.
+
+Usage (from project root):  python3 tools/bench_multiply.py
+"""
+import os
+import sys
+
+import gen_tables
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "sim6502"))
+import bench6502
+from bench6502 import s16
+
+gen_tables.build_tables()
+SIN_LUT = next(values for ctype, name, dims, values, comment in gen_tables.tables if name == "SIN_LUT")
+
+def word(out, k):
+    v = out[2 * k] | out[2 * k + 1] << 8
+    return v - 0x10000 if v & 0x8000 else v
+
+# --- Python models of the C, old and new alike (both are exact) ---
+def safe_mul_shift(a, b):
+    p = (abs(a) * abs(b)) >> 8
+    return -p if (a < 0) != (b < 0) else p
+
+def index(y):
+    return ((y * 41) >> 8) & 0xFF
+
+def splat(sx, sy):
+    return [(px + 320 * py) & 0xFFFF for py in (sy - 1, sy, sy + 1) for px in (sx - 1, sx, sx + 1)]
+
+def affine(scale, c, s):
+    return [(scale * v) >> 8 for v in (c, -s, s, c)]
+
+def collide(x1, y1, x2, y2):
+    dx, dy = (x1 - x2) >> 4, (y1 - y2) >> 4
+    return int(dx * dx + dy * dy < 200)
+
+def u16(v):
+    return [b & 0xFF for b in s16(v)]
+
+# Separations in px: every one near the collision radius, sparse beyond
+NEAR_FAR = sorted(set(range(-20, 21)) | set(range(-100, 101, 8)))
+
+# site: (label, per, inputs, args(input), check(input, old_out, new_out))
+SITES = {
+    "sms": ("safe_mul_shift", "call",
+            [(a, b) for a in range(-127, 128, 2) for b in range(-256, 257, 4)],
+            lambda i: u16(i[0]) + u16(i[1]),
+            lambda i, o, n: word(o, 0) == word(n, 0) == safe_mul_shift(*i)),
+    "index": ("attractor index", "index (2 per step)",
+              [(y,) for y in range(-1024, 1025, 3)],
+              lambda i: u16(i[0]),
+              lambda i, o, n: o[0] == n[0] == index(*i)),
+    "splat": ("splat addressing", "patch",
+              [(sx, sy) for sx in range(40, 281, 16) for sy in range(1, 179, 4)],
+              lambda i: u16(i[0]) + u16(i[1]),
+              lambda i, o, n: [word(o, k) & 0xFFFF for k in range(9)] == splat(*i)
+                              and [word(n, k) & 0xFFFF for k in range(3)] == splat(*i)[0::3]),
+    "affine": ("reticle affine", "frame",
+               [(scale, SIN_LUT[(a + 64) & 0xFF], SIN_LUT[a]) for scale in range(205, 308, 6) for a in range(0, 256, 4)],
+               lambda i: u16(i[0]) + u16(i[1]) + u16(i[2]),
+               lambda i, o, n: [word(o, k) for k in range(4)] == [word(n, k) for k in range(4)] == affine(*i)),
+    "collide": ("check_collision", "pair",
+                [(1600 + dx * 16 + dx % 16, 1200 + dy * 16 + dy % 7, 1600, 1200)
+                 for dx in NEAR_FAR for dy in NEAR_FAR],
+                lambda i: sum((u16(v) for v in i), []),
+                lambda i, o, n: o[0] == n[0] == collide(*i)),
+}
+
+def stats(c):
+    return f"min {min(c):5}  mean {sum(c) / len(c):7.1f}  max {max(c):5}"
+
+def main():
+    try:
+        with bench6502.Bench(["bench/runtime.s", "bench/fixedmath.s", "bench/multiply.s"]) as b:
+            runs = {}
+            for site, (label, per, inputs, args, check) in SITES.items():
+                old = b.run([(f"{site}_old", args(i)) for i in inputs])
+                new = b.run([(f"{site}_new", args(i)) for i in inputs])
+                for i, (co, oo), (cn, on) in zip(inputs, old, new):
+                    if not check(i, oo, on):
+                        print(f"{label}{i}: old {oo[:18]}, new {on[:18]} disagree with the model")
+                        return 1
+                runs[site] = [c for c, out in old], [c for c, out in new]
+    except bench6502.BenchError as e:
+        print(f"skipped ({str(e).strip()})")
+        return 0
+
+    print("Cycles per call site, JSR/RTS included (all results checked against the models):")
+    for site, (label, per, inputs, args, check) in SITES.items():
+        old, new = runs[site]
+        print(f"{label} ({len(inputs)} inputs), per {per}:")
+        print(f"  before : {stats(old)}")
+        print(f"  after  : {stats(new)}")
+        print(f"  saved  : {sum(old) / len(old) - sum(new) / len(new):.1f} ({sum(old) / sum(new):.1f}x)")
+
+    # check_collision is mostly called on near pairs now (sort-and-sweep)
+    label, per, inputs, args, check = SITES["collide"]
+    old, new = runs["collide"]
+    near = [k for k, i in enumerate(inputs) if abs(i[0] - i[2]) < 15 * 16 and abs(i[1] - i[3]) < 15 * 16]
+    print(f"  near pairs (|d| < 15 px, {len(near)}): before {sum(old[k] for k in near) / len(near):.1f}, "
+          f"after {sum(new[k] for k in near) / len(near):.1f}")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""
+Compare the table-driven orbit solver (src/fixedmath.c, solve_apocenter_orbit)
+against the division-based code it replaced, over the full spawn input range.
+
+Reports, per function:
+  - accuracy (exhaustive over the inputs the game can produce)
+  - the arithmetic each version performs per call
+  - cycles per solver call, before and after, on the W65C02S core in
+    tools/sim6502 (needs a host C++ compiler, $CXX)
+
+The tables come from tools/gen_tables.py, the generator of the shipped ones.
+Both solvers are hand-assembled in tools/sim6502/bench/orbit_solver.s,
+over models of the llvm-mos division helpers (bench/runtime.s), and are
+checked here against the Python models below before they are timed.
+
+Usage (from project root):  python3 tools/bench_orbit_solver.py
+"""
+import math
+import os
+import sys
+
+import gen_tables
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "sim6502"))
+import bench6502
+
+def load_tables():
+    gen_tables.build_tables()
+    return {name: values for ctype, name, dims, values, comment in gen_tables.tables}
+
+T = load_tables()
+
+# --- shared octant mapping (identical in both versions) ---
+def octant(x, y, ax, ay, base):
+    if ax >= ay:
+        if x >= 0: a = base if y >= 0 else 256 - base
+        else:      a = 128 - base if y >= 0 else 128 + base
+    else:
+        if y >= 0: a = 64 - base if x >= 0 else 64 + base
+        else:      a = 192 + base if x >= 0 else 192 - base
+    return a & 0xFF
+
+# --- previous implementations (division) ---
+def angle_div(x, y):
+    if x == 0 and y == 0: return 0
+    ax, ay = abs(x), abs(y)
+    mx, mn = (ax, ay) if ax > ay else (ay, ax)
+    base = 0
+    if mx > 1000: mx >>= 3; mn >>= 3
+    if mx > 0: base = (mn * 32) // mx
+    return octant(x, y, ax, ay, base)
+
+def radius_div(r, e, rmin):
+    a = (r * 256) // (256 + e)
+    return max(rmin, min(85, a))
+
+def speed_div(radius):
+    return max(20, min(255, 3500 // radius))
+
+# --- table implementations (mirror src/fixedmath.c) ---
+def angle_lut(x, y):
+    if x == 0 and y == 0: return 0
+    ax, ay = abs(x), abs(y)
+    mx, mn = (ax, ay) if ax > ay else (ay, ax)
+    while mx > 255: mx >>= 1; mn >>= 1
+    base = T["ATAN_LUT"][(T["LOG2_LUT"][mx] - T["LOG2_LUT"][mn]) & 0xFF] if mn > 0 else 0
+    return octant(x, y, ax, ay, base)
+
+def radius_lut(r, e, rmin):
+    r = min(r, 255)
+    a = r if e == 0 else (r * T["RECIP_1PE_LUT"][e]) >> 8
+    return max(rmin, min(85, a))
+
+def speed_lut(radius):
+    return T["ORBIT_SPEED_LUT"][radius]
+
+def angle_err(a, x, y):
+    true = (math.atan2(y, x) * 128 / math.pi) % 256
+    d = abs(a - true)
+    return min(d, 256 - d)
+
+def main():
+    # vector_to_angle: spawn offsets (pixels) and enemy motion deltas (12.4)
+    for label, rng in (("spawn offsets |d|<=160", 160), ("motion deltas |d|<=64", 64)):
+        worst = {"div": 0.0, "lut": 0.0}
+        total = {"div": 0.0, "lut": 0.0}
+        n = 0
+        for x in range(-rng, rng + 1):
+            for y in range(-rng, rng + 1):
+                if x == 0 and y == 0: continue
+                for k, fn in (("div", angle_div), ("lut", angle_lut)):
+                    e = angle_err(fn(x, y), x, y)
+                    worst[k] = max(worst[k], e)
+                    total[k] += e
+                n += 1
+        print(f"vector_to_angle [{label}] vs true atan2 (binary-angle units):")
+        print(f"  division : max {worst['div']:.2f}  mean {total['div'] / n:.2f}")
+        print(f"  tables   : max {worst['lut']:.2f}  mean {total['lut'] / n:.2f}")
+
+    # radius: r from the octagonal distance, e up to 128 (worker pulse max)
+    diff = 0; worst = 0; n = 0
+    for rmin in (20, 30):
+        for e in range(129):
+            for r in range(0, 206):
+                d = abs(radius_div(r, e, rmin) - radius_lut(r, e, rmin))
+                diff += d > 0; worst = max(worst, d); n += 1
+    print(f"radius a = r/(1+e): {diff}/{n} inputs differ, max |diff| {worst} px")
+
+    diff = sum(speed_div(r) != speed_lut(r) for r in range(20, 86))
+    print(f"speed 3500/a: {diff}/66 radii differ")
+
+    print()
+    print("Per-call arithmetic (spawn_worker / spawn_enemy / respawn):")
+    print("  division : 1x int32 div (r*256)/(256+e), 1x u16 div 3500/a,")
+    print("             1x s16 div in vector_to_angle (+2x u16 mod 160 on respawn)")
+    print("  tables   : 1x u8*u8 multiply, <=7 16-bit shifts, 5 table reads")
+
+    print()
+    return cycles()
+
+def cycles():
+    # Spawn offsets on an 8 px grid, a spread of eccentricities
+    inputs = [(dx, dy, e, 20) for dx in range(-160, 161, 8) for dy in range(-160, 161, 8)
+              for e in (0, 40, 80, 128)]
+    try:
+        with bench6502.Bench(["bench/runtime.s", "bench/fixedmath.s", "bench/orbit_solver.s"]) as b:
+            runs = {}
+            for name, angle, radius, speed in (("solve_div", angle_div, radius_div, speed_div),
+                                               ("solve_lut", angle_lut, radius_lut, speed_lut)):
+                results = b.run([(name, bench6502.s16(dx) + bench6502.s16(dy) + [e, rmin])
+                                 for dx, dy, e, rmin in inputs])
+                for (dx, dy, e, rmin), (c, out) in zip(inputs, results):
+                    ax, ay = abs(dx), abs(dy)
+                    r = max(ax, ay) + min(ax, ay) // 2
+                    a = radius(r, e, rmin)
+                    want = [(angle(dx, dy) + 128) & 0xFF, a, speed(a)]
+                    if out[:3] != want:
+                        print(f"{name}({dx}, {dy}, e={e}): got {out[:3]}, model {want}")
+                        return 1
+                runs[name] = [c for c, out in results]
+    except bench6502.BenchError as e:
+        print(f"Cycles: skipped ({str(e).strip()})")
+        return 0
+
+    print(f"Cycles per solve_apocenter_orbit ({len(inputs)} inputs, JSR/RTS included):")
+    for label, name in (("division", "solve_div"), ("tables", "solve_lut")):
+        c = runs[name]
+        print(f"  {label:9}: min {min(c):5}  mean {sum(c) / len(c):7.1f}  max {max(c):5}")
+    before, after = runs["solve_div"], runs["solve_lut"]
+    print(f"  saved    : {sum(before) / len(before) - sum(after) / len(after):.1f} cycles per call "
+          f"({sum(before) / sum(after):.1f}x)")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
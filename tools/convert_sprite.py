@@ -4,8 +4,11 @@ import sys
 import os
 import argparse
 import colorsys
+import io
 from PIL import Image
 
+import lz_pack
+
 def rp6502_pack_tile_bpp4(p1, p2):
     # Pack two 4-bit pixels into one byte
     # Pixel 1 in high nibble, Pixel 2 in low nibble
@@ -19,7 +22,39 @@ def rp6502_rgb_sprite_bpp16(r, g, b, a):
         # 16-bit RGB555 (1 bit alpha, 5 red, 5 green, 5 blue)
         return ((((b >> 3) << 11) | ((g >> 3) << 6) | (r >> 3)) | 1 << 5)
 
-def convert_image(image_path, output_path, mode):
+def rotate_frame(frame, headings, h):
+    # Heading h is the frame turned clockwise by h/headings of a full turn
+    # about its center. NEAREST keeps the hard alpha edge the VGA sampler uses.
+    if h == 0:
+        return frame
+    return frame.rotate(-360.0 * h / headings, resample=Image.NEAREST)
+
+def index_sprite(data, bpp):
+    # Indexed sprite asset: bpp, colour count, the shared RGB555 palette
+    # (index 0 = transparent), then one index per pixel, two per byte at
+    # 4bpp (high nibble first, as in tile mode). Mode 4 only draws RGB555,
+    # so asset.c expands it back into XRAM at boot; this is a ROM format.
+    pixels = [data[i] | data[i + 1] << 8 for i in range(0, len(data), 2)]
+    palette = [0]
+    for v in pixels:
+        if v not in palette:
+            palette.append(v)
+    if len(palette) > 1 << bpp:
+        print(f"Error: {len(palette) - 1} colours (+ transparent) do not fit {bpp}bpp.")
+        sys.exit(1)
+    index = {v: i for i, v in enumerate(palette)}
+    out = bytearray((bpp, len(palette) & 0xFF))
+    for v in palette:
+        out += v.to_bytes(2, "little")
+    if bpp == 4:
+        for i in range(0, len(pixels), 2):
+            out.append(rp6502_pack_tile_bpp4(index[pixels[i]], index[pixels[i + 1]]))
+    else:
+        out += bytes(index[v] for v in pixels)
+    print(f"Indexed:    {len(palette)} colours at {bpp}bpp, {len(data)} -> {len(out)} bytes")
+    return bytes(out)
+
+def convert_image(image_path, output_path, mode, headings=1, frames=None, packed=False, indexed=None):
     try:
         with Image.open(image_path) as im:
             # We need the original image for Palette/Index data
@@ -45,12 +80,39 @@ def convert_image(image_path, output_path, mode):
                 sys.exit(1)
                 
             num_frames = width // height
+            if frames is None:
+                frames = list(range(num_frames))
+            for i in frames:
+                if i >= num_frames:
+                    print(f"Error: Frame {i} out of range (image has {num_frames} frames).")
+                    sys.exit(1)
+
             print(f"Layout:     {num_frames} frames of {sprite_size}x{sprite_size}")
-            print(f"Output:     {output_path} [{mode}]")
+            if headings > 1:
+                print(f"Atlas:      frames {frames} x {headings} headings")
+            print(f"Output:     {output_path} [{mode}{', LZ' if packed else ''}]")
+
+            index_im = im
+            if mode == 'tile':
+                # Ensure we are using indices
+                if im.mode != 'P':
+                    print("WARNING: 'tile' mode requires an Indexed (Palette) PNG.")
+                    print("         Attempting to auto-quantize to 16 colors...")
+                    index_im = im.convert("P", palette=Image.ADAPTIVE, colors=16)
 
-            with open(output_path, "wb") as o:
-                for i in range(num_frames):
-                    base_x = i * sprite_size
+            # Pre-rotated atlas: every selected frame is cut out and written
+            # once per heading, frame-major. With headings == 1 this is the
+            # plain strip, so the original layout is unchanged.
+            atlas = []
+            for i in frames:
+                box = (i * sprite_size, 0, (i + 1) * sprite_size, sprite_size)
+                for h in range(headings):
+                    atlas.append((rotate_frame(index_im.crop(box), headings, h),
+                                  rotate_frame(rgb_im.crop(box), headings, h)))
+
+            with io.BytesIO() as o:
+                for frame_im, frame_rgb in atlas:
+                    base_x = 0
                     
                     # === MODE: TILE (4-bit Index) ===
                     if mode == 'tile':
@@ -58,19 +120,13 @@ def convert_image(image_path, output_path, mode):
                             print("Error: Sprite size must be even for Tile mode.")
                             sys.exit(1)
                         
-                        # Ensure we are using indices
-                        if im.mode != 'P':
-                            print("WARNING: 'tile' mode requires an Indexed (Palette) PNG.")
-                            print("         Attempting to auto-quantize to 16 colors...")
-                            use_im = im.convert("P", palette=Image.ADAPTIVE, colors=16)
-                        else:
-                            use_im = im
+                        use_im = frame_im
 
                         for y in range(sprite_size):
                             for x in range(base_x, base_x + sprite_size, 2):
                                 # Check alpha from ORIGINAL RGB image to enforce transparency
-                                r1, g1, b1, a1 = rgb_im.getpixel((x, y))
-                                r2, g2, b2, a2 = rgb_im.getpixel((x+1, y))
+                                r1, g1, b1, a1 = frame_rgb.getpixel((x, y))
+                                r2, g2, b2, a2 = frame_rgb.getpixel((x+1, y))
 
                                 if a1 < 128:
                                     p1 = 0 # Force transparent
@@ -89,10 +145,21 @@ def convert_image(image_path, output_path, mode):
                     else:
                         for y in range(sprite_size):
                             for x in range(base_x, base_x + sprite_size):
-                                r, g, b, a = rgb_im.getpixel((x, y))
+                                r, g, b, a = frame_rgb.getpixel((x, y))
                                 val = rp6502_rgb_sprite_bpp16(r, g, b, a)
                                 o.write(val.to_bytes(2, "little"))
-            
+                data = o.getvalue()
+
+            if indexed:
+                data = index_sprite(data, indexed)
+
+            # Packed: the LZ container unpacked at boot by xram_unlz
+            if packed:
+                lz_pack.write_packed(output_path, data)
+            else:
+                with open(output_path, "wb") as f:
+                    f.write(data)
+
             print("Done.")
 
     except FileNotFoundError:
@@ -108,13 +175,29 @@ def main():
     parser.add_argument("-o", "--output", help="Output BIN file.")
     parser.add_argument("--mode", choices=['sprite', 'tile', 'bitmap'], default='sprite', 
                         help="Mode: 'sprite' (16-bit), 'tile' (4-bit indices), or 'bitmap' (8-bit).")
+    parser.add_argument("--headings", type=int, default=1,
+                        help="Emit each frame pre-rotated to N evenly spaced headings (clockwise).")
+    parser.add_argument("--frames", default=None,
+                        help="Comma-separated frame indices to include (default: all).")
+    parser.add_argument("--indexed", type=int, choices=(4, 8),
+                        help="Sprite mode: write palette indices at 4 or 8 bpp plus one shared palette.")
+    parser.add_argument("--pack", action="store_true",
+                        help="Write the LZ container (tools/lz_pack.py) instead of raw pixels.")
 
     args = parser.parse_args()
 
     if not args.output:
         args.output = os.path.splitext(args.input_file)[0] + ".bin"
 
-    convert_image(args.input_file, args.output, args.mode)
+    if args.headings < 1:
+        parser.error("--headings must be at least 1")
+    frames = None
+    if args.frames:
+        frames = [int(f) for f in args.frames.split(",")]
+
+    if args.indexed and args.mode != 'sprite':
+        parser.error("--indexed needs --mode sprite")
+    convert_image(args.input_file, args.output, args.mode, args.headings, frames, args.pack, args.indexed)
 
 if __name__ == "__main__":
     main()
\ No newline at end of file
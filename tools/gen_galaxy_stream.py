@@ -0,0 +1,101 @@
+import argparse
+import struct
+
+import gen_tables
+
+# Precomputed galaxy stream for GALAXY_STREAM builds: every attractor step
+# of F frames, as galaxy_tick would compute it with no blasts nearby, so
+# the game only splats. Mirrors the fixed-point C loop in galaxy.c step
+# for step (same SIN_LUT, same truncations).
+#
+#   header  "GS", N, flags (bit 0: half resolution), frames (u16 LE)
+#   frame   N * N steps of two bytes: screen_x and screen_y minus the
+#           reach box corner (GALAXY_WIDTH / 2 - GALAXY_REACH, same for y),
+#           0..240 at full resolution
+#
+# Frames are 2 * N * N bytes, whole 512-byte read-ahead halves for N = 80,
+# so the file wraps on a half boundary.
+#
+# The game loops the file, so its last frame is followed by its first.
+# t is an 8.8 angle (2 pi = 1608) and the attractor repeats, near enough,
+# when t moves on by one turn. The default length is one turn of T_INC
+# steps, 322 frames (4,121,606 bytes): at the seam t moves back by 1610,
+# the x / y chain restarts from the first frame, and particles move about
+# as far as between any two frames. Other lengths make the seam a visible
+# jump (a mean 138 px per particle at 120 frames, against 11 per frame).
+
+N = 80
+RAD_SCALE = 41
+T_INC = 5
+T_TURN = 1608
+TURN_FRAMES = round(T_TURN / T_INC)
+STREAM_HALF = 512
+
+def s16(v):
+    v &= 0xFFFF
+    return v - 0x10000 if v & 0x8000 else v
+
+def sin_lut():
+    gen_tables.build_tables()
+    for ctype, name, dims, values, comment in gen_tables.tables:
+        if name == "SIN_LUT":
+            return values
+    raise RuntimeError("SIN_LUT missing from gen_tables.py")
+
+def generate(path, frames, seed, half_res):
+    shift = 1 if half_res else 0
+    width, height = 320 >> shift, 180 >> shift
+    scale = 60 >> shift
+    reach = (512 * scale) >> 8
+    x0, y0 = width // 2 - reach, height // 2 - reach
+    SIN = sin_lut()
+
+    # galaxy_randomize(seed)
+    x = s16(seed)
+    y = s16(seed * 3 + 12345)
+    t = s16(seed * 7 + 54321)
+
+    if (2 * N * N) % STREAM_HALF:
+        raise ValueError("frames must be whole read-ahead halves")
+
+    with open(path, "wb") as f:
+        f.write(b"GS" + struct.pack("<BBH", N, shift, frames))
+        for _ in range(frames):
+            # STATE_TIME
+            if t > T_TURN:
+                t -= T_TURN
+            t = s16(t + T_INC)
+
+            out = bytearray()
+            for i in range(N):
+                ri_idx = (i * 4) & 0xFF
+                i_rad_idx = (i * RAD_SCALE) & 0xFF
+                for _ in range(N):
+                    y_idx = ((y * RAD_SCALE) >> 8) & 0xFF
+                    x_idx = ((x * RAD_SCALE) >> 8) & 0xFF
+                    u1 = (i_rad_idx + y_idx) & 0xFF
+                    u2 = (ri_idx + x_idx) & 0xFF
+                    u = SIN[u1] + SIN[u2]
+                    v = SIN[(u1 + 64) & 0xFF] + SIN[(u2 + 64) & 0xFF]
+                    x = s16(u + t)
+                    y = v
+                    sx = ((u * scale) >> 8) + width // 2 - x0
+                    sy = ((v * scale) >> 8) + height // 2 - y0
+                    out += bytes((sx, sy))
+            f.write(out)
+
+    size = 6 + frames * 2 * N * N
+    print(f"Galaxy stream: {frames} frames of {N * N} steps, {size} bytes -> {path}")
+    if frames % TURN_FRAMES:
+        print(f"Galaxy stream: {frames} frames is not a multiple of {TURN_FRAMES}, the loop will jump")
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Precompute the galaxy attractor for GALAXY_STREAM")
+    parser.add_argument("-o", "--output", required=True)
+    parser.add_argument("--frames", type=int, default=TURN_FRAMES, help="default: one turn of t")
+    parser.add_argument("--seed", type=int, default=456, help="galaxy_randomize seed")
+    parser.add_argument("--half-res", action="store_true", help="GALAXY_HALF_RES coordinates")
+    args = parser.parse_args()
+    if not 1 <= args.frames <= 0xFFFF:
+        parser.error("--frames must be 1..65535")
+    generate(args.output, args.frames, args.seed, args.half_res)
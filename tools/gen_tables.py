@@ -1,28 +1,236 @@
-
+import argparse
 import math
+import os
+
+# Every lookup table lives in one object, tables.s, declared in tables.h,
+# so each is linked once however many files use it. Both are written at
+# build time into --out-dir, with only the tables the configuration uses:
+# --kernel adds galaxy_kernel.s's byte planes, --bpp 4 the 4bpp blends.
+# Tables are (ctype, name, dims, values, comment); values are flat,
+# row-major. The bitmap palette is not a table: --palette writes it as a
+# binary that CMake loads into XRAM (rp6502_asset).
+tables = []
+
+CTYPES = {"uint8_t": 1, "int16_t": 2, "uint16_t": 2}
+
+def add_table(ctype, name, values, comment=None, dims=None):
+    tables.append((ctype, name, dims or [len(values)], values, comment))
+
+def table_size(t):
+    ctype, _, _, values, _ = t
+    return CTYPES[ctype] * len(values)
+
+def blend(old, add, pink_mode, kill, bits=4):
+    # Mirrors the splat in galaxy.c: unpack, kill, saturating add, repack.
+    # bits is the width of each channel: 4 in a byte, 2 in a 4bpp nibble.
+    top = (1 << bits) - 1
+    pink, cyan = old >> bits, old & top
+    if kill:
+        if pink_mode: cyan = 0
+        else: pink = 0
+    if pink_mode: pink = pink + add if pink < top - add else top
+    else: cyan = cyan + add if cyan < top - add else top
+    return (pink << bits) | cyan
+
+# Hubble palette ramps (Teal & Gold), 16 levels per channel
+# Pink: Gold/Hydrogen (Rust -> Gold -> Pale Yellow)
+P_R = [20, 40, 60, 80, 100, 130, 160, 190, 210, 225, 235, 245, 250, 252, 255, 255]
+P_G = [5,  10, 20, 30,  45,  60,  80, 100, 120, 140, 160, 180, 200, 220, 240, 255]
+P_B = [0,   0,  0,  5,  10,  15,  25,  35,  50,  65,  85, 105, 130, 160, 190, 220]
+# Cyan: Azure/Oxygen (Deep Blue -> Teal -> Ice Blue)
+C_R = [0,   0,  0,  0,   5,  10,  20,  30,  45,  60,  80, 100, 130, 160, 190, 220]
+C_G = [5,  15, 30, 50,  70,  90, 110, 130, 150, 170, 190, 210, 225, 235, 245, 255]
+C_B = [20, 40, 60, 80, 100, 125, 150, 175, 200, 215, 225, 235, 245, 250, 252, 255]
+
+def palette_color(pink, cyan):
+    # Additive mix, clamped, in RP6502 BBBBB GGGGG A RRRRR with alpha set
+    r = min(255, P_R[pink] + C_R[cyan])
+    g = min(255, P_G[pink] + C_G[cyan])
+    b = min(255, P_B[pink] + C_B[cyan])
+    return ((b >> 3) << 11) | ((g >> 3) << 6) | (1 << 5) | (r >> 3)
+
+def palette(bits):
+    # Index = pink << bits | cyan. 4-bit channels use every ramp level,
+    # 2-bit channels levels 0, 5, 10 and 15. Index 0 is transparent for
+    # sprites.
+    top = (1 << bits) - 1
+    step = 15 // top
+    pal = [palette_color((i >> bits) * step, (i & top) * step) for i in range(1 << (2 * bits))]
+    pal[0] &= ~(1 << 5)
+    return pal
+
+def write_palette(path, bpp):
+    # Raw little-endian words, loaded at PALETTE_ADDR as an rp6502_asset
+    pal = palette(bpp // 2)
+    with open(path, "wb") as f:
+        for v in pal:
+            f.write(bytes((v & 0xFF, v >> 8)))
+    print(f"Palette: {len(pal)} colors, {2 * len(pal)} bytes -> {path}")
+
+def build_tables(kernel=False, bpp=8):
+    tables.clear()
+
+    # 256 entries for 0 to 2*PI
+    # Amplitude 1.0 = 256 (8.8 fixed point)
+    sin_lut = []
+    for i in range(256):
+        # i counts from 0 to 255 representing 0 to 2*PI
+        # angle = i * 2 * PI / 256
+        angle = i * 2 * math.pi / 256
+        sin_lut.append(int(math.sin(angle) * 256))
+    add_table("int16_t", "SIN_LUT", sin_lut, "sin(i * 2PI / 256) * 256")
+
+    # Reciprocal of (1 + e) for e in 0..255 (e/256 eccentricity)
+    # 65536 / (256 + e), so (a * RECIP_1PE_LUT[e]) >> 8 = a / (1 + e)
+    add_table("uint16_t", "RECIP_1PE_LUT", [round(65536 / (256 + e)) for e in range(256)],
+              "65536 / (256 + e): (a * RECIP_1PE_LUT[e]) >> 8 == a / (1 + e/256)")
 
-def generate_tables():
-    print("Generating tables.h...")
-    # Assumes running from project root
-    with open("src/tables.h", "w") as f:
+    # Keplerian speed 3500 / radius, clamped 20..255 (radius 0 -> 255)
+    add_table("uint8_t", "ORBIT_SPEED_LUT",
+              [255 if r == 0 else max(20, min(255, 3500 // r)) for r in range(256)],
+              "3500 / radius, clamped to 20..255")
+
+    # log2(v) * 32 for v in 1..255 (v = 0 unused)
+    add_table("uint8_t", "LOG2_LUT",
+              [0] + [min(255, round(math.log2(v) * 32)) for v in range(1, 256)],
+              "round(log2(v) * 32), v = 1..255")
+
+    # atan(2^(-d/32)) in binary angle units (32 = 45 degrees)
+    # d = LOG2_LUT[max] - LOG2_LUT[min], so this is atan(min / max)
+    add_table("uint8_t", "ATAN_LUT",
+              [round(math.atan(2 ** (-d / 32)) * 128 / math.pi) for d in range(256)],
+              "atan(2^(-d/32)) * 128 / PI: atan(min/max) from a LOG2_LUT difference")
+
+    # Quarter squares floor(n^2 / 4), n = 0..511, split into byte planes
+    # a * b = SQR[a + b] - SQR[|a - b|].
+    sqr = [(n * n) // 4 for n in range(512)]
+    add_table("uint8_t", "SQR_LO", [v & 0xFF for v in sqr],
+              "Quarter squares floor(n*n/4): a*b = SQR[a+b] - SQR[|a-b|]")
+    add_table("uint8_t", "SQR_HI", [v >> 8 for v in sqr])
+
+    # Splat blends, one page per (mode, amount): BLEND_LUT[mode * 2 + centre]
+    # maps an old framebuffer byte to the new one. Modes: 0 pink, 1 cyan,
+    # 2 infected (cyan, pink killed), 3 enriched (pink, cyan killed).
+    # Neighbours add 2, the centre adds 6.
+    modes = ((True, False), (False, False), (False, True), (True, True))
+    rows = [[blend(v, add, pink_mode, kill) for v in range(256)]
+            for pink_mode, kill in modes for add in (2, 6)]
+    add_table("uint8_t", "BLEND_LUT", sum(rows, []),
+              "Splat blends: BLEND_LUT[mode * 2 + centre][old] -> new pixel\n"
+              "mode 0 pink, 1 cyan, 2 infected, 3 enriched; +2 neighbour, +6 centre",
+              dims=[len(rows), 256])
+
+    # Same blends for the 4bpp framebuffer (GALAXY_4BPP): one 2-bit pink,
+    # 2-bit cyan pixel per nibble, neighbours add 1 and the centre 2.
+    if bpp == 4:
+        rows = [[blend(v, add, pink_mode, kill, bits=2) for v in range(16)]
+                for pink_mode, kill in modes for add in (1, 2)]
+        add_table("uint8_t", "BLEND4_LUT", sum(rows, []),
+                  "4bpp splat blends: BLEND4_LUT[mode * 2 + centre][old nibble] -> new nibble",
+                  dims=[len(rows), 16])
+
+    if not kernel:
+        return
+
+    # galaxy_kernel.s (USE_ASM_PARTICLES): SIN_LUT and SIN_LUT[i + 64] split
+    # into byte planes
+    cos_lut = [sin_lut[(i + 64) & 0xFF] for i in range(256)]
+    add_table("uint8_t", "SIN_LO", [v & 0xFF for v in sin_lut],
+              "galaxy_kernel.s: SIN_LUT and its cosine as byte planes")
+    add_table("uint8_t", "SIN_HI", [(v >> 8) & 0xFF for v in sin_lut])
+    add_table("uint8_t", "COS_LO", [v & 0xFF for v in cos_lut])
+    add_table("uint8_t", "COS_HI", [(v >> 8) & 0xFF for v in cos_lut])
+
+    # Top-left splat pixel for kernel row k = screen_y + 30: screen row
+    # k - 31, column 39, wrapped to 16 bits. The kernel adds
+    # screen_x - 40 to land on column screen_x - 1.
+    row_tl = [((k - 30 - 1) * 320 + 40 - 1) & 0xFFFF for k in range(241)]
+    add_table("uint8_t", "ROW_TL_LO", [v & 0xFF for v in row_tl],
+              "galaxy_kernel.s: top-left splat pixel address per kernel row")
+    add_table("uint8_t", "ROW_TL_HI", [v >> 8 for v in row_tl])
+
+def layout():
+    # Page-sized tables first, in declaration order, then the rest largest
+    # first. Returns (table, pad) pairs: a smaller table that would cross
+    # a page starts on the next one instead, so it never pays the
+    # page-cross cycle either.
+    paged = [t for t in tables if table_size(t) % 256 == 0]
+    rest = sorted((t for t in tables if table_size(t) % 256 != 0), key=table_size, reverse=True)
+    ordered, offset = [], 0
+    for t in paged + rest:
+        size = table_size(t)
+        pad = 0
+        if size < 256 and offset // 256 != (offset + size - 1) // 256:
+            pad = 256 - offset % 256
+        ordered.append((t, pad))
+        offset += pad + size
+    return ordered
+
+def report(ordered):
+    lines = [f"{'table':16} {'offset':>6} {'bytes':>6} {'pad':>4}"]
+    offset = total_pad = 0
+    for t, pad in ordered:
+        offset += pad
+        total_pad += pad
+        lines.append(f"{t[1]:16} {offset:6} {table_size(t):6} {pad:4}")
+        offset += table_size(t)
+    lines.append(f"{'total':16} {'':6} {offset:6} {total_pad:4}  (+ up to 255 before the section)")
+    return lines
+
+def generate_header(path):
+    print(f"Generating {path}...")
+    with open(path, "w") as f:
         f.write("#ifndef TABLES_H\n")
         f.write("#define TABLES_H\n\n")
         f.write("#include <stdint.h>\n\n")
-        
-        # 256 entries for 0 to 2*PI
-        # Amplitude 1.0 = 256 (8.8 fixed point)
-        f.write("static const int16_t SIN_LUT[256] = {\n")
-        for i in range(256):
-            # i counts from 0 to 255 representing 0 to 2*PI
-            # angle = i * 2 * PI / 256
-            angle = i * 2 * math.pi / 256
-            val = int(math.sin(angle) * 256)
-            f.write(f"    {val},")
-            if (i + 1) % 16 == 0:
-                f.write("\n")
-        f.write("};\n\n")
-        
-        f.write("#endif // TABLES_H\n")
+        f.write("// Generated by tools/gen_tables.py. One copy of each table, in tables.s.\n\n")
+        for k, (ctype, name, dims, values, comment) in enumerate(tables):
+            # A comment starts a group of related tables
+            if comment:
+                if k: f.write("\n")
+                for line in comment.split("\n"):
+                    f.write(f"// {line}\n")
+            f.write(f"extern const {ctype} {name}{''.join(f'[{d}]' for d in dims)};\n")
+        f.write("\n#endif // TABLES_H\n")
+
+def generate_object(path, ordered, lines):
+    print(f"Generating {path}...")
+    with open(path, "w") as f:
+        f.write("; Generated by tools/gen_tables.py - every lookup table, declared in\n")
+        f.write("; tables.h. The section starts on a page and page-sized tables come\n")
+        f.write("; first; no table crosses a page it does not have to.\n;\n")
+        for line in lines:
+            f.write(f"; {line}\n")
+        f.write("\n.section .rodata.tables,\"a\",@progbits\n")
+        f.write(".balign 256\n")
+        for (ctype, name, dims, values, comment), pad in ordered:
+            if pad: f.write("\n.balign 256")
+            f.write(f"\n.globl {name}\n{name}:\n")
+            if CTYPES[ctype] == 2:
+                for i in range(0, len(values), 16):
+                    f.write("    .short " + ", ".join(f"0x{v & 0xFFFF:04X}" for v in values[i:i + 16]) + "\n")
+            else:
+                for i in range(0, len(values), 16):
+                    f.write("    .byte " + ", ".join(f"0x{v:02X}" for v in values[i:i + 16]) + "\n")
 
 if __name__ == "__main__":
-    generate_tables()
+    parser = argparse.ArgumentParser(description="Generate lookup tables and the bitmap palette")
+    parser.add_argument("--palette", metavar="OUT", help="only write the palette binary to OUT")
+    parser.add_argument("--bpp", type=int, choices=(4, 8), default=8,
+                        help="bitmap depth: palette size, and the 4bpp blend table")
+    parser.add_argument("--out-dir", metavar="DIR", help="write tables.h and tables.s to DIR")
+    parser.add_argument("--kernel", action="store_true",
+                        help="add the galaxy_kernel.s tables (USE_ASM_PARTICLES)")
+    args = parser.parse_args()
+
+    if args.palette:
+        write_palette(args.palette, args.bpp)
+    elif args.out_dir:
+        build_tables(kernel=args.kernel, bpp=args.bpp)
+        ordered = layout()
+        lines = report(ordered)
+        generate_header(os.path.join(args.out_dir, "tables.h"))
+        generate_object(os.path.join(args.out_dir, "tables.s"), ordered, lines)
+        print("\n".join(lines))
+    else:
+        parser.error("one of --palette or --out-dir is required")
@@ -0,0 +1,148 @@
+import argparse
+import sys
+
+# Reads src/xram.layout (format described there), places every region,
+# checks for overlaps and writes xram_map.h and xram_map.cmake. The layout
+# report with the free gaps goes to stdout; errors go to stderr with a
+# non-zero exit, which stops the CMake configure.
+
+XRAM_SIZE = 0x10000
+
+def fail(msg):
+    print(f"xram.layout: {msg}", file=sys.stderr)
+    sys.exit(1)
+
+def parse(path, variables):
+    regions = []
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            fields = line.split()
+            if len(fields) < 3:
+                fail(f"line {lineno}: expected name, address, size")
+            options = [x for x in fields[2:] if "=" in x]
+            size_expr = " ".join(x for x in fields[2:] if "=" not in x)
+            opts = dict(o.split("=", 1) for o in options)
+
+            cond = opts.get("if")
+            if cond:
+                flag = cond.lstrip("!")
+                enabled = bool(variables.get(flag, 0))
+                if enabled == cond.startswith("!"):
+                    continue
+
+            try:
+                size = int(eval(size_expr, {"__builtins__": {}}, dict(variables)))
+            except Exception as e:
+                fail(f"line {lineno}: bad size '{size_expr}': {e}")
+            regions.append({
+                "name": fields[0],
+                "where": fields[1],
+                "size": size,
+                "align": int(opts.get("align", "1"), 0),
+                "line": lineno,
+            })
+    return regions
+
+def align_up(addr, align):
+    return (addr + align - 1) // align * align
+
+def gaps(placed):
+    spans = sorted((r["addr"], r["addr"] + r["size"]) for r in placed)
+    free, cursor = [], 0
+    for start, end in spans:
+        if start > cursor:
+            free.append((cursor, start))
+        cursor = max(cursor, end)
+    if cursor < XRAM_SIZE:
+        free.append((cursor, XRAM_SIZE))
+    return free
+
+def place(regions):
+    # Fixed and "next" regions in file order, then "auto" regions first fit
+    names = set()
+    placed, prev_end = [], 0
+    for r in regions:
+        if r["name"] in names:
+            fail(f"line {r['line']}: {r['name']} defined twice for this configuration")
+        names.add(r["name"])
+        if r["where"] == "auto":
+            continue
+        if r["where"] == "next":
+            r["addr"] = align_up(prev_end, r["align"])
+        else:
+            r["addr"] = int(r["where"], 0)
+            if r["addr"] % r["align"]:
+                fail(f"line {r['line']}: {r['name']} at 0x{r['addr']:04X} is not {r['align']}-byte aligned")
+        prev_end = r["addr"] + r["size"]
+        placed.append(r)
+
+    for r in regions:
+        if r["where"] != "auto":
+            continue
+        for start, end in gaps(placed):
+            addr = align_up(start, r["align"])
+            if addr + r["size"] <= end:
+                r["addr"] = addr
+                break
+        else:
+            fail(f"line {r['line']}: no free gap for {r['name']} ({r['size']} bytes)")
+        placed.append(r)
+
+    placed.sort(key=lambda r: r["addr"])
+    for a, b in zip(placed, placed[1:]):
+        if a["addr"] + a["size"] > b["addr"]:
+            fail(f"{a['name']} (0x{a['addr']:04X}-0x{a['addr'] + a['size']:04X}) overlaps "
+                 f"{b['name']} (0x{b['addr']:04X}-0x{b['addr'] + b['size']:04X})")
+    if placed and placed[-1]["addr"] + placed[-1]["size"] > XRAM_SIZE:
+        fail(f"{placed[-1]['name']} runs past the end of XRAM")
+    return placed
+
+def report(placed):
+    lines = [f"{'region':16} {'start':>6} {'end':>6} {'bytes':>6}"]
+    for r in placed:
+        lines.append(f"{r['name']:16} 0x{r['addr']:04X} 0x{r['addr'] + r['size']:04X} {r['size']:6}")
+    free = gaps(placed)
+    for start, end in free:
+        lines.append(f"{'(free)':16} 0x{start:04X} 0x{end:04X} {end - start:6}")
+    lines.append(f"{'free total':30} {sum(e - s for s, e in free):6}")
+    return lines
+
+def write_header(path, placed, lines):
+    with open(path, "w") as f:
+        f.write("// Generated by tools/gen_xram_map.py from src/xram.layout - do not edit\n")
+        f.write("#ifndef XRAM_MAP_H\n#define XRAM_MAP_H\n\n")
+        for line in lines:
+            f.write(f"// {line}\n")
+        f.write("\n")
+        for r in placed:
+            f.write(f"#define XRAM_{r['name']}_ADDR 0x{r['addr']:04X}U\n")
+            f.write(f"#define XRAM_{r['name']}_SIZE {r['size']}U\n")
+        f.write("\n#endif // XRAM_MAP_H\n")
+
+def write_cmake(path, placed):
+    with open(path, "w") as f:
+        f.write("# Generated by tools/gen_xram_map.py from src/xram.layout - do not edit\n")
+        for r in placed:
+            f.write(f"set(XRAM_{r['name']}_ASSET 0x{0x10000 + r['addr']:05X})\n")
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Place the XRAM layout and emit xram_map.h")
+    parser.add_argument("layout")
+    parser.add_argument("--header", required=True)
+    parser.add_argument("--cmake", required=True)
+    parser.add_argument("-D", dest="defs", action="append", default=[], metavar="NAME=VALUE")
+    args = parser.parse_args()
+
+    variables = {}
+    for d in args.defs:
+        name, _, value = d.partition("=")
+        variables[name] = int(value or "1", 0)
+
+    placed = place(parse(args.layout, variables))
+    lines = report(placed)
+    write_header(args.header, placed, lines)
+    write_cmake(args.cmake, placed)
+    print("\n".join(lines))
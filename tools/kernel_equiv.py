@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+Bit-exact check of the assembly particle kernel (src/galaxy_kernel.s)
+against the C particle loop in src/galaxy.c it replaces.
+
+Builds tools/sim6502/kernel_equiv.cpp twice on the host with src/galaxy.c
+and src/fixedmath.c: once plain, once with USE_ASM_PARTICLES, where each
+galaxy_particles_asm call runs the kernel on a cycle-counting W65C02S core
+(tools/sim6502/cpu6502.h) with the RIA portals mapped onto the same XRAM.
+Both run the same frames, entities and blast; the XRAM images must match
+byte for byte. Also prints the kernel's cycles per attractor step.
+
+The tables come from gen_tables.py (--kernel), the XRAM map from
+gen_xram_map.py, as in the CMake build. Needs a host C++ compiler
+($CXX, default c++).
+
+Usage (from project root):  python3 tools/kernel_equiv.py [--frames N]
+Exit status is 0 when the framebuffers match.
+"""
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+import gen_tables
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SIM = os.path.join(ROOT, "tools", "sim6502")
+SRC = os.path.join(ROOT, "src")
+sys.path.insert(0, SIM)
+import asm6502
+
+KERNEL_DATA = 0x7000 # galaxy_kernel in the 6502 image (asm6502.py data segment)
+BITMAP_SIZE = 320 * 180
+
+def write_tables(out_dir):
+    # tables.h / tables.s as the build makes them, plus C definitions of
+    # the same tables for the host side
+    gen_tables.build_tables(kernel=True)
+    ordered = gen_tables.layout()
+    gen_tables.generate_header(os.path.join(out_dir, "tables.h"))
+    gen_tables.generate_object(os.path.join(out_dir, "tables.s"), ordered, gen_tables.report(ordered))
+    path = os.path.join(out_dir, "tables.c")
+    with open(path, "w") as f:
+        f.write('#include "tables.h"\n')
+        for ctype, name, dims, values, comment in gen_tables.tables:
+            f.write(f"const {ctype} {name}{''.join(f'[{d}]' for d in dims)} = {{\n")
+            for i in range(0, len(values), 16):
+                f.write("    " + ", ".join(str(v) for v in values[i:i + 16]) + ",\n")
+            f.write("};\n")
+    return path
+
+def run(cmd, **kw):
+    r = subprocess.run(cmd, capture_output=True, **kw)
+    if r.returncode:
+        sys.stderr.write(r.stderr.decode(errors="replace"))
+        sys.exit(f"kernel_equiv: {os.path.basename(cmd[0])} failed")
+    return r
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare galaxy_kernel.s with the C particle loop")
+    parser.add_argument("--frames", type=int, default=30, help="frames to run (a blast lives frames 2-23)")
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "c++"), help="host C++ compiler")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        tables_c = write_tables(tmp)
+        run([sys.executable, os.path.join(ROOT, "tools", "gen_xram_map.py"),
+             os.path.join(SRC, "xram.layout"), "--header", os.path.join(tmp, "xram_map.h"),
+             "--cmake", os.path.join(tmp, "xram_map.cmake"), "-D", "SPRITE_HEADINGS=6"])
+
+        image, symbols = asm6502.assemble([os.path.join(SRC, "galaxy_kernel.s"), os.path.join(tmp, "tables.s")],
+                                          {"galaxy_kernel": KERNEL_DATA})
+        img, sym = os.path.join(tmp, "kernel.img"), os.path.join(tmp, "kernel.sym")
+        asm6502.write(image, symbols, img, sym)
+
+        dumps = {}
+        for name, defs in (("c", []), ("asm", ["-DUSE_ASM_PARTICLES"])):
+            exe = os.path.join(tmp, f"equiv_{name}")
+            run([args.cxx, "-O1", "-w", "-fpermissive", "-D_Static_assert=static_assert", *defs,
+                 "-I", SIM, "-I", SRC, "-I", tmp, "-x", "c++",
+                 os.path.join(SRC, "galaxy.c"), os.path.join(SRC, "fixedmath.c"), tables_c,
+                 os.path.join(SIM, "kernel_equiv.cpp"), "-o", exe])
+            r = run([exe, str(args.frames), img, sym])
+            dumps[name] = r.stdout
+            print(f"{name:4}: {r.stderr.decode().strip()}".replace("\n", "\n      "))
+
+    c, asm = dumps["c"], dumps["asm"]
+    diff = [a for a in range(len(c)) if c[a] != asm[a]]
+    if diff:
+        print(f"MISMATCH: {len(diff)} XRAM bytes differ, first at 0x{diff[0]:04X} "
+              f"(c {c[diff[0]]:02X}, asm {asm[diff[0]]:02X})")
+        return 1
+    lit = sum(1 for v in c[:BITMAP_SIZE] if v)
+    print(f"OK: XRAM identical after {args.frames} frames ({lit} lit framebuffer bytes)")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,147 @@
+import argparse
+import os
+import struct
+
+# LZ container for XRAM assets, unpacked on the 6502 by xram_unlz
+# (src/xram.s). Byte-aligned so the decoder is a handful of portal moves:
+#
+#   header  "LZ", raw size (u16 LE), stream size (u16 LE)
+#   stream  tokens until 0x00:
+#     0x01-0x7F  t literal bytes follow
+#     0x80-0xFF  match: copy (t & 0x7F) + MIN_MATCH bytes from offset
+#                (u16 LE, 1 = the previous byte) back in the output
+#     0x00       end
+#
+# The format allows a match to overlap its own output (offset < length),
+# but xram_unlz only decodes that right if a write through portal 0
+# refreshes RW1 when portal 1 points at the same address, which is not
+# confirmed on hardware. Until it is, OVERLAP is off: matches stop at
+# length == offset, so a run packs as a doubling chain of matches instead
+# of a single one, and unpack rejects streams that overlap. Any file fits
+# the container, music tracks included; raw size is capped at 64 KB, the
+# size of XRAM.
+
+MAGIC = b"LZ"
+HEADER = 6
+MIN_MATCH = 4  # A match costs 3 bytes
+MAX_MATCH = 0x7F + MIN_MATCH
+MAX_LITERALS = 0x7F
+MAX_OFFSET = 0xFFFF
+OVERLAP = False  # See above: needs the RIA's RW1 refresh
+
+def longest_match(data, pos, heads):
+    # Longest earlier match for data[pos:], nearest first on ties
+    best_len, best_off = 0, 0
+    limit = min(MAX_MATCH, len(data) - pos)
+    if limit < MIN_MATCH:
+        return 0, 0
+    for start in reversed(heads.get(data[pos:pos + MIN_MATCH], ())):
+        off = pos - start
+        if off > MAX_OFFSET:
+            break
+        n, most = 0, limit if OVERLAP else min(limit, off)
+        while n < most and data[start + n] == data[pos + n]:
+            n += 1
+        if n > best_len:
+            best_len, best_off = n, off
+            if n == limit:
+                break
+    return best_len, best_off
+
+def pack(data):
+    # Greedy with one step of lazy matching: take a match only if the
+    # one starting at the next byte is not longer.
+    if len(data) > 0x10000:
+        raise ValueError("raw data over 64 KB")
+    heads = {}
+    out = bytearray()
+    literals = bytearray()
+
+    def insert(p):
+        heads.setdefault(data[p:p + MIN_MATCH], []).append(p)
+
+    def flush():
+        for i in range(0, len(literals), MAX_LITERALS):
+            chunk = literals[i:i + MAX_LITERALS]
+            out.append(len(chunk))
+            out.extend(chunk)
+        literals.clear()
+
+    pos = 0
+    while pos < len(data):
+        length, off = longest_match(data, pos, heads)
+        if length >= MIN_MATCH:
+            insert(pos)
+            nxt, _ = longest_match(data, pos + 1, heads)
+            if nxt <= length:
+                flush()
+                out.append(0x80 | (length - MIN_MATCH))
+                out.extend(struct.pack("<H", off))
+                for p in range(pos + 1, pos + length):
+                    insert(p)
+                pos += length
+                continue
+            literals.append(data[pos])
+            pos += 1
+            continue
+        insert(pos)
+        literals.append(data[pos])
+        pos += 1
+    flush()
+    out.append(0)
+    return MAGIC + struct.pack("<HH", len(data) & 0xFFFF, len(out)) + bytes(out)
+
+def unpack(blob):
+    # Reference decoder, the same loop as xram_unlz
+    if blob[:2] != MAGIC:
+        raise ValueError("not an LZ container")
+    raw_size, stream_size = struct.unpack_from("<HH", blob, 2)
+    src, out = HEADER, bytearray()
+    while True:
+        t = blob[src]
+        src += 1
+        if t == 0:
+            break
+        if t < 0x80:
+            out.extend(blob[src:src + t])
+            src += t
+        else:
+            off = blob[src] | blob[src + 1] << 8
+            src += 2
+            if not OVERLAP and off < (t & 0x7F) + MIN_MATCH:
+                raise ValueError("overlapping match, which xram_unlz may not decode")
+            for _ in range((t & 0x7F) + MIN_MATCH):
+                out.append(out[-off])
+    if src != HEADER + stream_size or len(out) & 0xFFFF != raw_size:
+        raise ValueError("corrupt LZ container")
+    return bytes(out)
+
+def write_packed(path, data, name=None):
+    # Pack, check the round trip and print the ratio for the build log
+    blob = pack(data)
+    if unpack(blob) != data:
+        raise RuntimeError(f"{path}: LZ round trip failed")
+    with open(path, "wb") as f:
+        f.write(blob)
+    print(f"LZ: {name or path}: {len(data)} -> {len(blob)} bytes "
+          f"({100 * len(blob) / max(1, len(data)):.0f}%)")
+    return blob
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Pack files into the xram_unlz LZ container")
+    parser.add_argument("inputs", nargs="+")
+    parser.add_argument("-o", "--output", help="output file (one input only; default: input with .lz)")
+    parser.add_argument("-d", "--decode", action="store_true", help="unpack instead")
+    args = parser.parse_args()
+
+    if args.output and len(args.inputs) > 1:
+        parser.error("-o takes a single input")
+    for path in args.inputs:
+        with open(path, "rb") as f:
+            data = f.read()
+        if args.decode:
+            out = args.output or os.path.splitext(path)[0] + ".bin"
+            with open(out, "wb") as f:
+                f.write(unpack(data))
+        else:
+            write_packed(args.output or os.path.splitext(path)[0] + ".lz", data, path)
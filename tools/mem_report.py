@@ -0,0 +1,138 @@
+import argparse
+import os
+import re
+from collections import defaultdict
+
+# Memory report from the lld map file (-Wl,-Map): bytes per module in each
+# kind of section, the largest symbols, and how much RAM is left between
+# the end of static data and the soft stack. On the RP6502 the whole
+# program runs from RAM, so "image" is what gets loaded (code, rodata,
+# data) and bss/zp are what it claims on top.
+
+# lld map line: VMA LMA Size(hex) Align, then Out / In / Symbol, each
+# column indented 8 more than the last
+LINE = re.compile(r"^\s*([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+(\d+) (.*)$")
+ASSIGN = re.compile(r"^(\w+) = ")
+
+KINDS = ("text", "rodata", "data", "bss", "zp")
+
+def kind_of(section):
+    if section.startswith(".zp"):
+        return "zp"
+    for prefix, kind in ((".text", "text"), (".init", "text"), (".fini", "text"),
+                         (".rodata", "rodata"), (".data", "data"),
+                         (".bss", "bss"), (".noinit", "bss")):
+        if section.startswith(prefix):
+            return kind
+    return None # Debug info, symtab, ...
+
+def module_of(path):
+    # "dir/galaxy.c.obj:(.text.galaxy_tick)" -> "galaxy"
+    # "dir/libc.a(printf.cc.obj):(.text.printf)" -> "libc.a"
+    path = path.split(":(", 1)[0]
+    m = re.match(r"(.*\.a)\(", path)
+    if m:
+        return os.path.basename(m.group(1))
+    name = os.path.basename(path)
+    for ext in (".obj", ".o"):
+        if name.endswith(ext):
+            name = name[:-len(ext)]
+    for ext in (".c", ".s", ".S", ".cc"):
+        if name.endswith(ext):
+            name = name[:-len(ext)]
+    return name
+
+def parse(path):
+    modules = defaultdict(lambda: dict.fromkeys(KINDS, 0))
+    symbols = [] # (name, module, kind, size)
+    assigns = {}
+    out_kind = None
+    cur = None # Current input section: module, kind, end, symbol list
+
+    def close_input():
+        # Symbol sizes: distance to the next symbol, or to the section end
+        if not cur or not cur["syms"]:
+            return
+        syms = sorted(cur["syms"])
+        for (addr, name), nxt in zip(syms, syms[1:] + [(cur["end"], None)]):
+            symbols.append((name, cur["module"], cur["kind"], nxt[0] - addr))
+
+    with open(path) as f:
+        for line in f:
+            m = LINE.match(line)
+            if not m:
+                continue
+            vma, size = int(m.group(1), 16), int(m.group(3), 16)
+            rest = m.group(5)
+            indent = len(rest) - len(rest.lstrip(" "))
+            text = rest.strip()
+
+            a = ASSIGN.match(text)
+            if a:
+                assigns[a.group(1)] = vma
+                continue
+
+            if indent == 0: # Output section
+                close_input()
+                cur = None
+                out_kind = kind_of(text)
+            elif indent == 8: # Input section
+                close_input()
+                cur = None
+                if out_kind and size:
+                    module = module_of(text)
+                    modules[module][out_kind] += size
+                    cur = {"module": module, "kind": out_kind, "end": vma + size, "syms": []}
+            elif cur: # Symbol
+                cur["syms"].append((vma, text))
+        close_input()
+    return modules, symbols, assigns
+
+def report(modules, symbols, assigns, top):
+    lines = [f"{'module':16}" + "".join(f"{k:>8}" for k in KINDS) + f"{'total':>8}"]
+    totals = dict.fromkeys(KINDS, 0)
+    for name, sizes in sorted(modules.items(), key=lambda kv: -sum(kv[1].values())):
+        lines.append(f"{name:16}" + "".join(f"{sizes[k]:8}" for k in KINDS) + f"{sum(sizes.values()):8}")
+        for k in KINDS:
+            totals[k] += sizes[k]
+    lines.append(f"{'total':16}" + "".join(f"{totals[k]:8}" for k in KINDS) + f"{sum(totals.values()):8}")
+
+    image = totals["text"] + totals["rodata"] + totals["data"]
+    lines.append("")
+    lines.append(f"image (text + rodata + data) {image}, bss {totals['bss']}, zp {totals['zp']}")
+    if "__heap_start" in assigns and "__stack" in assigns:
+        free = assigns["__stack"] - assigns["__heap_start"]
+        lines.append(f"free RAM for the soft stack: {free} "
+                     f"(0x{assigns['__heap_start']:04X}-0x{assigns['__stack']:04X})")
+
+    if top:
+        lines.append("")
+        lines.append(f"{'largest symbols':32} {'module':16} {'kind':6} {'bytes':>6}")
+        for name, module, kind, size in sorted(symbols, key=lambda s: -s[3])[:top]:
+            lines.append(f"{name:32} {module:16} {kind:6} {size:6}")
+    return lines
+
+def per_symbol(symbols):
+    # Every symbol, grouped by module, largest first
+    lines = []
+    by_module = defaultdict(list)
+    for s in symbols:
+        by_module[s[1]].append(s)
+    for module in sorted(by_module):
+        lines.append(f"{module}:")
+        for name, _, kind, size in sorted(by_module[module], key=lambda s: -s[3]):
+            lines.append(f"    {name:32} {kind:6} {size:6}")
+    return lines
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="RAM/ROM usage per module from an lld map file")
+    parser.add_argument("map")
+    parser.add_argument("--top", type=int, default=16, help="largest symbols to list")
+    parser.add_argument("--symbols", metavar="OUT", help="also write every symbol, by module, to OUT")
+    args = parser.parse_args()
+
+    modules, symbols, assigns = parse(args.map)
+    print("\n".join(report(modules, symbols, assigns, args.top)))
+    if args.symbols:
+        with open(args.symbols, "w") as f:
+            f.write("\n".join(per_symbol(symbols)) + "\n")
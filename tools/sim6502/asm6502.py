@@ -0,0 +1,262 @@
+import argparse
+import re
+import sys
+
+# Assembler for the llvm-mos syntax used in src/*.s, enough to run those
+# files on the host core (cpu6502.h). Not a linker: sections are placed by
+# kind at fixed addresses, C symbols come in as -D name=value, and the
+# compiler's imaginary registers __rc0..__rc31 sit at 0x00-0x1F.
+#
+#   zp      0x80-0xFF      text    0x2000-0x3FFF
+#   rodata  0x4000-0x5FFF  data    0x6000-0x7FFF (also bss)
+#
+# Output is a 64 KB memory image plus a "name value" symbol file, one per
+# line, which Cpu6502::load reads. Supports .section, .globl, .set,
+# .balign, .zero, .byte, .short/.word, .rept/.endr, local .L labels and
+# numbered labels (1: ... 1b / 1f), mos8() and mos16lo/hi().
+
+OPS = {
+    "adc": {"imm": 0x69, "zp": 0x65, "zpx": 0x75, "abs": 0x6D, "absx": 0x7D, "absy": 0x79, "indx": 0x61, "indy": 0x71, "ind": 0x72},
+    "and": {"imm": 0x29, "zp": 0x25, "zpx": 0x35, "abs": 0x2D, "absx": 0x3D, "absy": 0x39, "indx": 0x21, "indy": 0x31, "ind": 0x32},
+    "asl": {"acc": 0x0A, "zp": 0x06, "zpx": 0x16, "abs": 0x0E, "absx": 0x1E},
+    "bit": {"imm": 0x89, "zp": 0x24, "zpx": 0x34, "abs": 0x2C, "absx": 0x3C},
+    "bpl": {"rel": 0x10}, "bmi": {"rel": 0x30}, "bvc": {"rel": 0x50}, "bvs": {"rel": 0x70},
+    "bcc": {"rel": 0x90}, "bcs": {"rel": 0xB0}, "bne": {"rel": 0xD0}, "beq": {"rel": 0xF0},
+    "bra": {"rel": 0x80},
+    "cmp": {"imm": 0xC9, "zp": 0xC5, "zpx": 0xD5, "abs": 0xCD, "absx": 0xDD, "absy": 0xD9, "indx": 0xC1, "indy": 0xD1, "ind": 0xD2},
+    "cpx": {"imm": 0xE0, "zp": 0xE4, "abs": 0xEC},
+    "cpy": {"imm": 0xC0, "zp": 0xC4, "abs": 0xCC},
+    "dec": {"acc": 0x3A, "zp": 0xC6, "zpx": 0xD6, "abs": 0xCE, "absx": 0xDE},
+    "eor": {"imm": 0x49, "zp": 0x45, "zpx": 0x55, "abs": 0x4D, "absx": 0x5D, "absy": 0x59, "indx": 0x41, "indy": 0x51, "ind": 0x52},
+    "clc": {"imp": 0x18}, "sec": {"imp": 0x38}, "cli": {"imp": 0x58}, "sei": {"imp": 0x78},
+    "clv": {"imp": 0xB8}, "cld": {"imp": 0xD8},
+    "inc": {"acc": 0x1A, "zp": 0xE6, "zpx": 0xF6, "abs": 0xEE, "absx": 0xFE},
+    "jmp": {"abs": 0x4C, "ind": 0x6C},
+    "jsr": {"abs": 0x20},
+    "lda": {"imm": 0xA9, "zp": 0xA5, "zpx": 0xB5, "abs": 0xAD, "absx": 0xBD, "absy": 0xB9, "indx": 0xA1, "indy": 0xB1, "ind": 0xB2},
+    "ldx": {"imm": 0xA2, "zp": 0xA6, "zpy": 0xB6, "abs": 0xAE, "absy": 0xBE},
+    "ldy": {"imm": 0xA0, "zp": 0xA4, "zpx": 0xB4, "abs": 0xAC, "absx": 0xBC},
+    "lsr": {"acc": 0x4A, "zp": 0x46, "zpx": 0x56, "abs": 0x4E, "absx": 0x5E},
+    "nop": {"imp": 0xEA},
+    "ora": {"imm": 0x09, "zp": 0x05, "zpx": 0x15, "abs": 0x0D, "absx": 0x1D, "absy": 0x19, "indx": 0x01, "indy": 0x11, "ind": 0x12},
+    "tax": {"imp": 0xAA}, "txa": {"imp": 0x8A}, "dex": {"imp": 0xCA}, "inx": {"imp": 0xE8},
+    "tay": {"imp": 0xA8}, "tya": {"imp": 0x98}, "dey": {"imp": 0x88}, "iny": {"imp": 0xC8},
+    "rol": {"acc": 0x2A, "zp": 0x26, "zpx": 0x36, "abs": 0x2E, "absx": 0x3E},
+    "ror": {"acc": 0x6A, "zp": 0x66, "zpx": 0x76, "abs": 0x6E, "absx": 0x7E},
+    "rts": {"imp": 0x60},
+    "sbc": {"imm": 0xE9, "zp": 0xE5, "zpx": 0xF5, "abs": 0xED, "absx": 0xFD, "absy": 0xF9, "indx": 0xE1, "indy": 0xF1, "ind": 0xF2},
+    "sta": {"zp": 0x85, "zpx": 0x95, "abs": 0x8D, "absx": 0x9D, "absy": 0x99, "indx": 0x81, "indy": 0x91, "ind": 0x92},
+    "stx": {"zp": 0x86, "zpy": 0x96, "abs": 0x8E},
+    "sty": {"zp": 0x84, "zpx": 0x94, "abs": 0x8C},
+    "stz": {"zp": 0x64, "zpx": 0x74, "abs": 0x9C, "absx": 0x9E},
+    "tsb": {"zp": 0x04, "abs": 0x0C}, "trb": {"zp": 0x14, "abs": 0x1C},
+    "txs": {"imp": 0x9A}, "tsx": {"imp": 0xBA},
+    "pha": {"imp": 0x48}, "pla": {"imp": 0x68}, "phx": {"imp": 0xDA}, "plx": {"imp": 0xFA},
+    "phy": {"imp": 0x5A}, "ply": {"imp": 0x7A}, "php": {"imp": 0x08}, "plp": {"imp": 0x28},
+}
+SIZE = {"imp": 1, "acc": 1, "imm": 2, "zp": 2, "zpx": 2, "zpy": 2, "abs": 3, "absx": 3,
+        "absy": 3, "ind": 2, "indx": 2, "indy": 2, "rel": 2}
+SEGMENTS = {"zp": (0x80, 0x100), "text": (0x2000, 0x4000),
+            "rodata": (0x4000, 0x6000), "data": (0x6000, 0x8000)}
+
+class AsmError(Exception):
+    pass
+
+def segment_of(section):
+    for kind in ("zp", "text", "rodata"):
+        if section.startswith("." + kind):
+            return kind
+    return "data"
+
+def to_python(expr):
+    expr = expr.replace("mos16lo(", "_lo(").replace("mos16hi(", "_hi(").replace("mos8(", "(")
+    return re.sub(r"\.L(\w+)", r"_L_\1", expr)
+
+def split_mode(mn, operand):
+    # (mode, expression) for one instruction operand
+    op = operand.strip()
+    if op in ("", "a"):
+        return ("acc" if "acc" in OPS[mn] else "imp"), None
+    if op.startswith("#"):
+        return "imm", op[1:]
+    if "rel" in OPS[mn]:
+        return "rel", op
+    m = re.fullmatch(r"\((.*)\)\s*,\s*y", op)
+    if m:
+        return "indy", m.group(1)
+    m = re.fullmatch(r"\((.*)\s*,\s*x\)", op)
+    if m:
+        return "indx", m.group(1)
+    index = ""
+    m = re.fullmatch(r"(.*?)\s*,\s*([xy])", op)
+    if m:
+        op, index = m.group(1), m.group(2)
+    zp = op.startswith("mos8(")
+    if not index and op.startswith("(") and op.endswith(")") and not zp:
+        inner = op[1:-1]
+        return ("ind", inner) if mn == "jmp" or inner.startswith("mos8(") else ("abs", op)
+    return ("zp" if zp else "abs") + index, op
+
+def read_lines(paths):
+    lines = []
+    for path in paths:
+        with open(path) as f:
+            for line in f:
+                line = line.split(";")[0].rstrip()
+                if line.strip():
+                    lines.append(line)
+    return lines
+
+def expand_rept(lines, symbols):
+    out, i = [], 0
+    while i < len(lines):
+        words = lines[i].split()
+        if words[0] == ".rept":
+            count = int(eval(to_python(words[1]), {}, symbols))
+            body = []
+            i += 1
+            while lines[i].split()[0] != ".endr":
+                body.append(lines[i])
+                i += 1
+            out += body * count
+        else:
+            out.append(lines[i])
+        i += 1
+    return out
+
+def rename_numbered(lines):
+    # "1:" becomes _N1_<k> for its k-th definition; 1b / 1f refer to the
+    # nearest one before / after.
+    count, seen, out = {}, {}, []
+    for line in lines:
+        m = re.match(r"\s*(\d+):(.*)", line)
+        if m:
+            count[m.group(1)] = count.get(m.group(1), 0) + 1
+            line = f"_N{m.group(1)}_{count[m.group(1)]}:" + m.group(2)
+        out.append(line)
+    resolved = []
+    for line in out:
+        m = re.match(r"_N(\d+)_(\d+):", line)
+        if m:
+            seen[m.group(1)] = int(m.group(2))
+        label, body = (line.split(":", 1) if m else (None, line))
+        body = re.sub(r"\b(\d+)([fb])\b",
+                      lambda r: f"_N{r.group(1)}_{seen.get(r.group(1), 0) + (r.group(2) == 'f')}", body)
+        resolved.append(f"{label}:{body}" if m else body)
+    return resolved
+
+def assemble(paths, defines=None):
+    # Returns (64 KB image, {symbol: address})
+    symbols = {"_lo": lambda v: v & 0xFF, "_hi": lambda v: (v >> 8) & 0xFF}
+    symbols.update({f"__rc{n}": n for n in range(32)})
+    symbols.update(defines or {})
+    lines = rename_numbered(expand_rept(read_lines(paths), symbols))
+
+    def value(expr):
+        try:
+            return eval(to_python(expr), {}, symbols)
+        except Exception as e:
+            raise AsmError(f"cannot evaluate '{expr}': {e}")
+
+    for final in (False, True):
+        pc = {k: lo for k, (lo, hi) in SEGMENTS.items()}
+        seg = "text"
+        mem = {}
+
+        def emit(b):
+            mem[pc[seg]] = b & 0xFF
+            pc[seg] += 1
+
+        for line in lines:
+            s = line.strip()
+            m = re.match(r"([\w.]+):\s*(.*)", s)
+            if m:
+                name = re.sub(r"^\.L", "_L_", m.group(1))
+                if not final and name in symbols and name not in (defines or {}):
+                    raise AsmError(f"duplicate label {m.group(1)}")
+                symbols[name] = pc[seg]
+                s = m.group(2)
+                if not s:
+                    continue
+            words = s.split(None, 1)
+            d, rest = words[0], (words[1] if len(words) > 1 else "")
+            if d == ".set":
+                k, v = [w.strip() for w in rest.split(",", 1)]
+                symbols[k] = value(v)
+            elif d == ".section":
+                seg = segment_of(rest.split(",")[0].strip())
+            elif d in (".globl", ".global", ".type", ".size", ".text", ".p2align"):
+                pass
+            elif d == ".balign":
+                while pc[seg] % int(rest, 0):
+                    pc[seg] += 1
+            elif d == ".zero":
+                pc[seg] += value(rest)
+            elif d == ".byte":
+                for v in rest.split(","):
+                    emit(value(v) if final else 0)
+            elif d in (".short", ".word"):
+                for v in rest.split(","):
+                    w = value(v) if final else 0
+                    emit(w)
+                    emit(w >> 8)
+            else:
+                mn = d.lower()
+                if mn not in OPS:
+                    raise AsmError(f"unknown instruction: {line.strip()}")
+                mode, expr = split_mode(mn, rest)
+                if mode not in OPS[mn]:
+                    raise AsmError(f"bad addressing mode ({mode}): {line.strip()}")
+                if not final:
+                    pc[seg] += SIZE[mode]
+                    continue
+                v = value(expr) if expr is not None else 0
+                emit(OPS[mn][mode])
+                if mode == "rel":
+                    off = v - (pc[seg] + 1)
+                    if not -128 <= off <= 127:
+                        raise AsmError(f"branch out of range: {line.strip()}")
+                    emit(off)
+                elif SIZE[mode] == 2:
+                    if mode != "imm" and not 0 <= v <= 0xFF:
+                        raise AsmError(f"zero page operand out of range: {line.strip()}")
+                    emit(v)
+                elif SIZE[mode] == 3:
+                    emit(v)
+                    emit(v >> 8)
+        for k, (lo, hi) in SEGMENTS.items():
+            if pc[k] > hi:
+                raise AsmError(f"{k} overflows 0x{hi:04X}")
+
+    image = bytearray(0x10000)
+    for a, b in mem.items():
+        image[a] = b
+    symbols = {k: v for k, v in symbols.items() if isinstance(v, int)}
+    for k in SEGMENTS:
+        symbols[f"__end_{k}"] = pc[k]
+    return bytes(image), symbols
+
+def write(image, symbols, image_path, sym_path):
+    with open(image_path, "wb") as f:
+        f.write(image)
+    with open(sym_path, "w") as f:
+        for k, v in symbols.items():
+            f.write(f"{k} {v}\n")
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Assemble src/*.s into a memory image for cpu6502.h")
+    parser.add_argument("sources", nargs="+")
+    parser.add_argument("-o", "--output", required=True, help="64 KB memory image")
+    parser.add_argument("-s", "--symbols", required=True, help="symbol file")
+    parser.add_argument("-D", dest="defines", action="append", default=[], metavar="NAME=VALUE",
+                        help="external symbol, e.g. a C global")
+    args = parser.parse_args()
+    defines = {}
+    for d in args.defines:
+        k, v = d.split("=", 1)
+        defines[k] = int(v, 0)
+    try:
+        image, symbols = assemble(args.sources, defines)
+    except AsmError as e:
+        sys.exit(f"asm6502: {e}")
+    write(image, symbols, args.output, args.symbols)
@@ -0,0 +1,112 @@
+; fixedmath.s - src/fixedmath.c multiplies, hand-assembled for the benches
+;
+; Written the way that C reads, one routine per function, against the
+; SQR_LO / SQR_HI quarter-square tables from tables.s. Arguments and
+; results live in zero page: fm_a, fm_b in, fm_p out, little-endian.
+; smul16x8 takes its arguments' magnitudes in place.
+
+.section .zp.bss.fixedmath,"zaw",@nobits
+fm_a: .zero 2
+fm_b: .zero 1
+fm_p: .zero 4
+
+.section .text.fixedmath,"ax",@progbits
+
+; fm_p = fm_a * fm_b, 8x8 -> 16: SQR[a + b] - SQR[|a - b|]
+umul8x8:
+    lda mos8(fm_a)
+    sec
+    sbc mos8(fm_b)
+    bcs 1f
+    eor #0xFF           ; carry clear: ~d + 1 = b - a
+    adc #1
+1:
+    tay
+    lda mos8(fm_a)
+    clc
+    adc mos8(fm_b)
+    tax
+    bcs 2f
+    lda SQR_LO,x
+    sec
+    sbc SQR_LO,y
+    sta mos8(fm_p)
+    lda SQR_HI,x
+    sbc SQR_HI,y
+    sta mos8(fm_p+1)
+    rts
+2:
+    lda SQR_LO+256,x    ; a + b >= 256
+    sec
+    sbc SQR_LO,y
+    sta mos8(fm_p)
+    lda SQR_HI+256,x
+    sbc SQR_HI,y
+    sta mos8(fm_p+1)
+    rts
+
+; fm_p = fm_a * fm_b, 16x8 -> 24: (hi * b) << 8 + lo * b
+umul16x8:
+    jsr umul8x8
+    lda mos8(fm_p)
+    pha
+    ldx mos8(fm_p+1)
+    lda mos8(fm_a)
+    pha
+    lda mos8(fm_a+1)
+    sta mos8(fm_a)
+    phx
+    jsr umul8x8
+    plx
+    pla
+    sta mos8(fm_a)
+    txa
+    clc
+    adc mos8(fm_p)
+    tax
+    lda mos8(fm_p+1)
+    adc #0
+    sta mos8(fm_p+2)
+    stx mos8(fm_p+1)
+    pla
+    sta mos8(fm_p)
+    rts
+
+; fm_p = fm_a * fm_b, signed 16x8 -> 32
+smul16x8:
+    lda mos8(fm_a+1)
+    eor mos8(fm_b)
+    pha
+    bit mos8(fm_a+1)
+    bpl 1f
+    sec
+    lda #0
+    sbc mos8(fm_a)
+    sta mos8(fm_a)
+    lda #0
+    sbc mos8(fm_a+1)
+    sta mos8(fm_a+1)
+1:
+    bit mos8(fm_b)
+    bpl 2f
+    sec
+    lda #0
+    sbc mos8(fm_b)
+    sta mos8(fm_b)
+2:
+    jsr umul16x8
+    stz mos8(fm_p+3)
+    pla
+    bpl 3f
+    sec
+    ldx #0
+    ldy #4
+4:
+    lda #0
+    sbc mos8(fm_p),x
+    sta mos8(fm_p),x
+    inx
+    dey
+    bne 4b
+3:
+    rts
@@ -0,0 +1,521 @@
+; multiply.s - the quarter-square call sites before and after
+;
+; One routine pair per site, <site>_old with the multiply the code used to
+; make (through the runtime models in runtime.s), <site>_new with the
+; fixedmath.s routine it makes now. Work both versions share (signs,
+; shifts, clamps) is written once and called from both.
+;
+;   site        bench_args                  bench_out
+;   sms         a (s16), b (s16)            safe_mul_shift(a, b) (s16)
+;   index       y (s16)                     (y * RAD_SCALE) >> 8 (byte)
+;   splat       screen_x, screen_y (s16)    XRAM addresses (u16 each):
+;                                           old 3x3 row-major, new the
+;                                           left column of each row
+;   affine      scale (s16), c, s (s16)     A, B, C, D (s16)
+;   collide     x1, y1, x2, y2 (s16, 12.4)  check_collision (0 / 1)
+
+.set RAD_SCALE, 41
+.set SCREEN_WIDTH, 320
+
+.section .data.bench,"aw",@progbits
+bench_args: .zero 8
+bench_out:  .zero 32
+
+.section .zp.bss.multiply,"zaw",@nobits
+mu_a:    .zero 2
+mu_b:    .zero 2
+mu_sign: .zero 1
+mu_sx:   .zero 2
+mu_sy:   .zero 2
+mu_row:  .zero 2
+mu_n:    .zero 1
+
+.section .text.multiply,"ax",@progbits
+
+; --- physics.c safe_mul_shift: (|a| * |b|) >> 8 with the sign put back ---
+
+sms_old:
+    jsr sms_abs
+    lda mos8(mu_a)
+    sta mos8(rt_n)
+    lda mos8(mu_a+1)
+    sta mos8(rt_n+1)
+    lda mos8(mu_b)
+    sta mos8(rt_d)
+    lda mos8(mu_b+1)
+    sta mos8(rt_d+1)
+    jsr __mulhi3        ; (uint16_t)a * (uint16_t)b
+    lda mos8(rt_r+1)
+    sta bench_out
+    stz bench_out+1
+    bra sms_sign
+
+sms_new:
+    jsr sms_abs
+    lda mos8(mu_b)
+    sta mos8(fm_a)
+    lda mos8(mu_b+1)
+    sta mos8(fm_a+1)
+    lda mos8(mu_a)
+    sta mos8(fm_b)
+    jsr umul16x8        ; umul16x8(b, (uint8_t)a)
+    lda mos8(fm_p+1)
+    sta bench_out
+    lda mos8(fm_p+2)
+    sta bench_out+1
+    ; fall through
+
+sms_sign:
+    bit mos8(mu_sign)
+    bpl 1f
+    sec
+    lda #0
+    sbc bench_out
+    sta bench_out
+    lda #0
+    sbc bench_out+1
+    sta bench_out+1
+1:
+    rts
+
+; mu_a = |a|, mu_b = |b|, mu_sign bit 7 set when the signs differ
+sms_abs:
+    lda bench_args+1
+    eor bench_args+3
+    sta mos8(mu_sign)
+    ldx #0
+1:
+    lda bench_args+1,x
+    bpl 2f
+    sec
+    lda #0
+    sbc bench_args,x
+    sta mos8(mu_a),x
+    lda #0
+    sbc bench_args+1,x
+    sta mos8(mu_a+1),x
+    bra 3f
+2:
+    sta mos8(mu_a+1),x
+    lda bench_args,x
+    sta mos8(mu_a),x
+3:
+    inx
+    inx
+    cpx #4
+    bne 1b
+    rts
+
+; --- galaxy.c attractor index: (uint8_t)((y * RAD_SCALE) >> 8) ---
+
+index_old:
+    lda bench_args
+    sta mos8(rt_n)
+    lda bench_args+1
+    sta mos8(rt_n+1)
+    and #0x80           ; (int32_t)y
+    beq 1f
+    lda #0xFF
+1:
+    sta mos8(rt_n+2)
+    sta mos8(rt_n+3)
+    lda #RAD_SCALE
+    sta mos8(rt_d)
+    stz mos8(rt_d+1)
+    stz mos8(rt_d+2)
+    stz mos8(rt_d+3)
+    jsr __mulsi3
+    lda mos8(rt_r+1)
+    sta bench_out
+    rts
+
+index_new:
+    lda bench_args
+    sta mos8(fm_a)
+    lda bench_args+1
+    sta mos8(fm_a+1)
+    lda #RAD_SCALE
+    sta mos8(fm_b)
+    jsr smul16x8
+    lda mos8(fm_p+1)
+    sta bench_out
+    rts
+
+; --- galaxy.c splat addressing, one 3x3 patch ---
+
+; Nine px + SCREEN_WIDTH * py, one multiply per pixel
+splat_old:
+    ldy #0              ; bench_out offset
+    lda bench_args+2    ; py = screen_y - 1
+    sec
+    sbc #1
+    sta mos8(mu_sy)
+    lda bench_args+3
+    sbc #0
+    sta mos8(mu_sy+1)
+    lda #3
+    sta mos8(mu_n)
+1:
+    lda bench_args      ; px = screen_x - 1
+    sec
+    sbc #1
+    sta mos8(mu_sx)
+    lda bench_args+1
+    sbc #0
+    sta mos8(mu_sx+1)
+    ldx #3
+2:
+    phx
+    phy
+    lda #mos16lo(SCREEN_WIDTH)
+    sta mos8(rt_n)
+    lda #mos16hi(SCREEN_WIDTH)
+    sta mos8(rt_n+1)
+    lda mos8(mu_sy)
+    sta mos8(rt_d)
+    lda mos8(mu_sy+1)
+    sta mos8(rt_d+1)
+    jsr __mulhi3
+    ply
+    plx
+    clc
+    lda mos8(rt_r)
+    adc mos8(mu_sx)
+    sta bench_out,y
+    lda mos8(rt_r+1)
+    adc mos8(mu_sx+1)
+    sta bench_out+1,y
+    iny
+    iny
+    inc mos8(mu_sx)     ; px++
+    bne 3f
+    inc mos8(mu_sx+1)
+3:
+    dex
+    bne 2b
+    inc mos8(mu_sy)     ; py++
+    bne 4f
+    inc mos8(mu_sy+1)
+4:
+    dec mos8(mu_n)
+    bne 1b
+    rts
+
+; One umul16x8 for the top row, then += SCREEN_WIDTH per row
+splat_new:
+    lda bench_args+2    ; top = screen_y - 1
+    sec
+    sbc #1
+    sta mos8(mu_sy)
+    lda bench_args+3
+    sbc #0
+    sta mos8(mu_sy+1)
+    bpl 1f
+    lda #0              ; (uint8_t)-top
+    sec
+    sbc mos8(mu_sy)
+    bra 2f
+1:
+    lda mos8(mu_sy)
+2:
+    sta mos8(fm_b)
+    lda #mos16lo(SCREEN_WIDTH)
+    sta mos8(fm_a)
+    lda #mos16hi(SCREEN_WIDTH)
+    sta mos8(fm_a+1)
+    jsr umul16x8
+    lda mos8(fm_p)
+    sta mos8(mu_row)
+    lda mos8(fm_p+1)
+    sta mos8(mu_row+1)
+    bit mos8(mu_sy+1)
+    bpl 3f
+    sec                 ; row_addr = -row_addr
+    lda #0
+    sbc mos8(mu_row)
+    sta mos8(mu_row)
+    lda #0
+    sbc mos8(mu_row+1)
+    sta mos8(mu_row+1)
+3:
+    lda bench_args      ; screen_x - 1
+    sec
+    sbc #1
+    sta mos8(mu_sx)
+    lda bench_args+1
+    sbc #0
+    sta mos8(mu_sx+1)
+    ldy #0
+4:
+    clc                 ; addr = (screen_x - 1) + row_addr
+    lda mos8(mu_sx)
+    adc mos8(mu_row)
+    sta bench_out,y
+    lda mos8(mu_sx+1)
+    adc mos8(mu_row+1)
+    sta bench_out+1,y
+    clc                 ; row_addr += SCREEN_WIDTH
+    lda mos8(mu_row)
+    adc #mos16lo(SCREEN_WIDTH)
+    sta mos8(mu_row)
+    lda mos8(mu_row+1)
+    adc #mos16hi(SCREEN_WIDTH)
+    sta mos8(mu_row+1)
+    iny
+    iny
+    cpy #6
+    bne 4b
+    rts
+
+; --- sprites.c reticle affine: A, B, C, D = scale * (c, -s, s, c) >> 8 ---
+
+; Four ((int32_t)scale * v) >> 8
+affine_old:
+    ldx #2              ; c
+    ldy #0
+    jsr affine_mul32
+    ldx #4              ; -s
+    jsr affine_neg
+    ldy #2
+    jsr affine_mul32
+    ldx #4              ; s
+    ldy #4
+    jsr affine_mul32
+    ldx #2              ; c
+    ldy #6
+    jmp affine_mul32
+
+; bench_out+Y = ((int32_t)scale * bench_args[X]) >> 8
+affine_mul32:
+    phy
+    lda bench_args
+    sta mos8(rt_n)
+    lda bench_args+1
+    sta mos8(rt_n+1)
+    stz mos8(rt_n+2)    ; scale > 0
+    stz mos8(rt_n+3)
+    lda bench_args,x
+    sta mos8(rt_d)
+    lda bench_args+1,x
+    sta mos8(rt_d+1)
+    and #0x80
+    beq 1f
+    lda #0xFF
+1:
+    sta mos8(rt_d+2)
+    sta mos8(rt_d+3)
+    jsr __mulsi3
+    ply
+    lda mos8(rt_r+1)
+    sta bench_out,y
+    lda mos8(rt_r+2)
+    sta bench_out+1,y
+    rts
+
+; bench_args[6..7] = -bench_args[X]; X = 6
+affine_neg:
+    sec
+    lda #0
+    sbc bench_args,x
+    sta bench_args+6
+    lda #0
+    sbc bench_args+1,x
+    sta bench_args+7
+    ldx #6
+    rts
+
+; scale_q8 for A, B, C; D = A
+affine_new:
+    ldx #2
+    ldy #0
+    jsr scale_q8
+    ldx #4
+    jsr affine_neg
+    ldy #2
+    jsr scale_q8
+    ldx #4
+    ldy #4
+    jsr scale_q8
+    lda bench_out
+    sta bench_out+6
+    lda bench_out+1
+    sta bench_out+7
+    rts
+
+; bench_out+Y = scale_q8(scale, bench_args[X])
+scale_q8:
+    lda bench_args+1,x  ; mag = |v|
+    sta mos8(mu_sign)
+    bpl 1f
+    sec
+    lda #0
+    sbc bench_args,x
+    sta mos8(mu_a)
+    lda #0
+    sbc bench_args+1,x
+    sta mos8(mu_a+1)
+    bra 2f
+1:
+    sta mos8(mu_a+1)
+    lda bench_args,x
+    sta mos8(mu_a)
+2:
+    lda mos8(mu_a+1)    ; mag > 255: p = scale << 8
+    beq 3f
+    stz mos8(fm_p)
+    lda bench_args
+    sta mos8(fm_p+1)
+    lda bench_args+1
+    sta mos8(fm_p+2)
+    bra 4f
+3:
+    phy
+    lda bench_args
+    sta mos8(fm_a)
+    lda bench_args+1
+    sta mos8(fm_a+1)
+    lda mos8(mu_a)
+    sta mos8(fm_b)
+    jsr umul16x8
+    ply
+4:
+    bit mos8(mu_sign)
+    bmi 5f
+    lda mos8(fm_p+1)    ; p >> 8
+    sta bench_out,y
+    lda mos8(fm_p+2)
+    sta bench_out+1,y
+    rts
+5:
+    clc                 ; -((p + 255) >> 8)
+    lda mos8(fm_p)
+    adc #0xFF
+    lda mos8(fm_p+1)
+    adc #0
+    tax
+    lda mos8(fm_p+2)
+    adc #0
+    sta mos8(mu_a+1)
+    sec
+    lda #0
+    stx mos8(mu_a)
+    sbc mos8(mu_a)
+    sta bench_out,y
+    lda #0
+    sbc mos8(mu_a+1)
+    sta bench_out+1,y
+    rts
+
+; --- sprites.c check_collision ---
+
+collide_old:
+    jsr collide_delta
+    lda mos8(mu_a)      ; dx * dx
+    sta mos8(rt_n)
+    sta mos8(rt_d)
+    lda mos8(mu_a+1)
+    sta mos8(rt_n+1)
+    sta mos8(rt_d+1)
+    jsr __mulhi3
+    lda mos8(rt_r)
+    sta mos8(mu_row)
+    lda mos8(rt_r+1)
+    sta mos8(mu_row+1)
+    lda mos8(mu_b)      ; dy * dy
+    sta mos8(rt_n)
+    sta mos8(rt_d)
+    lda mos8(mu_b+1)
+    sta mos8(rt_n+1)
+    sta mos8(rt_d+1)
+    jsr __mulhi3
+    clc
+    lda mos8(rt_r)
+    adc mos8(mu_row)
+    tax
+    lda mos8(rt_r+1)
+    adc mos8(mu_row+1)
+    ; (int16_t) sum < 200
+    bmi 1f
+    bne 2f
+    cpx #200
+    bcs 2f
+1:
+    lda #1
+    sta bench_out
+    rts
+2:
+    stz bench_out
+    rts
+
+collide_new:
+    jsr collide_delta
+    ldx #0              ; |dx|, |dy|; either >= 15 is a miss
+1:
+    lda mos8(mu_a+1),x
+    bpl 2f
+    sec
+    lda #0
+    sbc mos8(mu_a),x
+    sta mos8(mu_a),x
+    lda #0
+    sbc mos8(mu_a+1),x
+    sta mos8(mu_a+1),x
+2:
+    lda mos8(mu_a+1),x
+    bne 4f
+    lda mos8(mu_a),x
+    cmp #15
+    bcs 4f
+    inx
+    inx
+    cpx #4
+    bne 1b
+    lda mos8(mu_a)
+    sta mos8(fm_a)
+    sta mos8(fm_b)
+    jsr umul8x8
+    lda mos8(fm_p)
+    sta mos8(mu_row)
+    lda mos8(mu_b)
+    sta mos8(fm_a)
+    sta mos8(fm_b)
+    jsr umul8x8
+    clc                 ; both squares <= 196: the sum is < 512
+    lda mos8(fm_p)
+    adc mos8(mu_row)
+    tax
+    lda mos8(fm_p+1)
+    adc #0
+    bne 4f
+    cpx #200
+    bcs 4f
+    lda #1
+    sta bench_out
+    rts
+4:
+    stz bench_out
+    rts
+
+; mu_a = (x1 - x2) >> 4, mu_b = (y1 - y2) >> 4, arithmetic shifts
+collide_delta:
+    ldx #0
+1:
+    sec
+    lda bench_args,x
+    sbc bench_args+4,x
+    sta mos8(mu_a),x
+    lda bench_args+1,x
+    sbc bench_args+5,x
+    ldy #4
+2:
+    cmp #0x80
+    ror
+    ror mos8(mu_a),x
+    dey
+    bne 2b
+    sta mos8(mu_a+1),x
+    inx
+    inx
+    cpx #4
+    bne 1b
+    rts
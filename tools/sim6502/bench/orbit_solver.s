@@ -0,0 +1,310 @@
+; orbit_solver.s - solve_apocenter_orbit before and after the table solver
+;
+; solve_div: vector_to_angle with (min * 32) / max, a = (r * 256) / (256 + e)
+;            through __divsi3, speed 3500 / a through __divhi3
+; solve_lut: src/fixedmath.c as it is now: LOG2_LUT / ATAN_LUT angle,
+;            div_one_plus (RECIP_1PE_LUT and umul8x8), ORBIT_SPEED_LUT
+;
+; Both share sv_prep (|dx|, |dy|, max, min, octagonal r) and sv_octant,
+; so the difference in cycles is the solver arithmetic alone.
+;
+; bench_args: dx (s16), dy (s16), eccentricity, min_radius
+; bench_out:  omega, radius, speed
+
+.section .data.bench,"aw",@progbits
+bench_args: .zero 8
+bench_out:  .zero 32
+
+.section .zp.bss.orbit_solver,"zaw",@nobits
+sv_ax:   .zero 2
+sv_ay:   .zero 2
+sv_mx:   .zero 2
+sv_mn:   .zero 2
+sv_r:    .zero 2
+sv_base: .zero 1
+
+.section .text.orbit_solver,"ax",@progbits
+
+solve_div:
+    jsr sv_prep
+    ; if (max > 1000) { max >>= 3; min >>= 3; }
+    lda #0xE8
+    cmp mos8(sv_mx)
+    lda #0x03
+    sbc mos8(sv_mx+1)
+    bcs 2f
+    ldx #3
+1:
+    lsr mos8(sv_mx+1)
+    ror mos8(sv_mx)
+    lsr mos8(sv_mn+1)
+    ror mos8(sv_mn)
+    dex
+    bne 1b
+2:
+    ; base = max ? (min * 32) / max : 0
+    stz mos8(sv_base)
+    lda mos8(sv_mx)
+    ora mos8(sv_mx+1)
+    beq 4f
+    lda mos8(sv_mn)
+    sta mos8(rt_n)
+    lda mos8(sv_mn+1)
+    ldx #5
+3:
+    asl mos8(rt_n)
+    rol
+    dex
+    bne 3b
+    sta mos8(rt_n+1)
+    lda mos8(sv_mx)
+    sta mos8(rt_d)
+    lda mos8(sv_mx+1)
+    sta mos8(rt_d+1)
+    jsr __divhi3
+    lda mos8(rt_n)
+    sta mos8(sv_base)
+4:
+    jsr sv_octant
+
+    ; a = (int32_t)(r * 256) / (256 + e)
+    stz mos8(rt_n)
+    lda mos8(sv_r)
+    sta mos8(rt_n+1)
+    lda mos8(sv_r+1)
+    sta mos8(rt_n+2)
+    stz mos8(rt_n+3)
+    lda bench_args+4
+    sta mos8(rt_d)
+    lda #1
+    sta mos8(rt_d+1)
+    stz mos8(rt_d+2)
+    stz mos8(rt_d+3)
+    jsr __divsi3
+    lda mos8(rt_n+1)
+    ora mos8(rt_n+2)
+    ora mos8(rt_n+3)
+    bne 5f
+    lda mos8(rt_n)
+    cmp #86
+    bcc 6f
+5:
+    lda #85
+6:
+    cmp bench_args+5
+    bcs 7f
+    lda bench_args+5
+7:
+    sta bench_out+1
+
+    ; speed = 3500 / a, clamped 20..255
+    sta mos8(rt_d)
+    stz mos8(rt_d+1)
+    lda #0xAC
+    sta mos8(rt_n)
+    lda #0x0D
+    sta mos8(rt_n+1)
+    jsr __divhi3
+    lda mos8(rt_n+1)
+    bne 8f
+    lda mos8(rt_n)
+    cmp #20
+    bcs 9f
+    lda #20
+    bra 9f
+8:
+    lda #255
+9:
+    sta bench_out+2
+    rts
+
+solve_lut:
+    jsr sv_prep
+    ; while (max > 255) { max >>= 1; min >>= 1; }
+1:
+    lda mos8(sv_mx+1)
+    beq 2f
+    lsr mos8(sv_mx+1)
+    ror mos8(sv_mx)
+    lsr mos8(sv_mn+1)
+    ror mos8(sv_mn)
+    bra 1b
+2:
+    ; base = min ? ATAN_LUT[LOG2_LUT[max] - LOG2_LUT[min]] : 0
+    lda #0
+    ldx mos8(sv_mn)
+    beq 3f
+    ldy mos8(sv_mx)
+    lda LOG2_LUT,y
+    sec
+    sbc LOG2_LUT,x
+    tax
+    lda ATAN_LUT,x
+3:
+    sta mos8(sv_base)
+    jsr sv_octant
+
+    ; a = div_one_plus(min(r, 255), e)
+    lda mos8(sv_r+1)
+    beq 4f
+    lda #255
+    bra 5f
+4:
+    lda mos8(sv_r)
+5:
+    ldy bench_args+4
+    beq 6f
+    sta mos8(fm_a)
+    tya                 ; RECIP_1PE_LUT[e] is a uint16_t; e >= 1 keeps it < 256
+    asl
+    tax
+    bcs 7f
+    lda RECIP_1PE_LUT,x
+    bra 10f
+7:
+    lda RECIP_1PE_LUT+256,x
+10:
+    sta mos8(fm_b)
+    jsr umul8x8
+    lda mos8(fm_p+1)
+6:
+    cmp #86
+    bcc 8f
+    lda #85
+8:
+    cmp bench_args+5
+    bcs 9f
+    lda bench_args+5
+9:
+    sta bench_out+1
+    tax
+    lda ORBIT_SPEED_LUT,x
+    sta bench_out+2
+    rts
+
+; sv_ax = |dx|, sv_ay = |dy|, sv_mx / sv_mn their max / min,
+; sv_r = max + min / 2
+sv_prep:
+    ldx #0
+1:
+    lda bench_args+1,x
+    bpl 2f
+    sec
+    lda #0
+    sbc bench_args,x
+    sta mos8(sv_ax),x
+    lda #0
+    sbc bench_args+1,x
+    sta mos8(sv_ax+1),x
+    bra 3f
+2:
+    sta mos8(sv_ax+1),x
+    lda bench_args,x
+    sta mos8(sv_ax),x
+3:
+    inx
+    inx
+    cpx #4
+    bne 1b
+
+    lda mos8(sv_ay)
+    cmp mos8(sv_ax)
+    lda mos8(sv_ay+1)
+    sbc mos8(sv_ax+1)
+    bcs 4f
+    ldx #0              ; |dx| > |dy|: max = |dx|
+    jsr sv_maxmin
+    bra 5f
+4:
+    ldx #2
+    jsr sv_maxmin
+5:
+    lda mos8(sv_mn+1)
+    lsr
+    tax
+    lda mos8(sv_mn)
+    ror
+    clc
+    adc mos8(sv_mx)
+    sta mos8(sv_r)
+    txa
+    adc mos8(sv_mx+1)
+    sta mos8(sv_r+1)
+    rts
+
+; sv_mx = (sv_ax / sv_ay at X), sv_mn = the other
+sv_maxmin:
+    lda mos8(sv_ax),x
+    sta mos8(sv_mx)
+    lda mos8(sv_ax+1),x
+    sta mos8(sv_mx+1)
+    txa
+    eor #2
+    tax
+    lda mos8(sv_ax),x
+    sta mos8(sv_mn)
+    lda mos8(sv_ax+1),x
+    sta mos8(sv_mn+1)
+    rts
+
+; bench_out+0 = omega = phi + 128, phi from sv_base and the octant
+sv_octant:
+    lda mos8(sv_ax)
+    cmp mos8(sv_ay)
+    lda mos8(sv_ax+1)
+    sbc mos8(sv_ay+1)
+    bcc 3f
+    ; x dominant: offset from 0 or 128
+    bit bench_args+1
+    bmi 2f
+    bit bench_args+3
+    bmi 1f
+    lda mos8(sv_base)
+    bra 9f
+1:
+    lda #0
+    sec
+    sbc mos8(sv_base)
+    bra 9f
+2:
+    bit bench_args+3
+    bmi 1f
+    lda #128
+    sec
+    sbc mos8(sv_base)
+    bra 9f
+1:
+    lda #128
+    clc
+    adc mos8(sv_base)
+    bra 9f
+3:
+    ; y dominant: offset from 64 or 192
+    bit bench_args+3
+    bmi 2f
+    bit bench_args+1
+    bmi 1f
+    lda #64
+    sec
+    sbc mos8(sv_base)
+    bra 9f
+1:
+    lda #64
+    clc
+    adc mos8(sv_base)
+    bra 9f
+2:
+    bit bench_args+1
+    bmi 1f
+    lda #192
+    clc
+    adc mos8(sv_base)
+    bra 9f
+1:
+    lda #192
+    sec
+    sbc mos8(sv_base)
+9:
+    eor #0x80
+    sta bench_out
+    rts
@@ -0,0 +1,224 @@
+; runtime.s - models of the llvm-mos runtime helpers the removed code called
+;
+; The compiler turns a non-constant multiply or divide into a call to
+; these. Without an llvm-mos toolchain here they are written out by hand
+; as the textbook loops the runtime uses: multiply is shift-add over the
+; first operand, stopping once no bits are left; division is a
+; fixed-width shift-subtract (16 or 32 iterations), the signed forms
+; divide the magnitudes and fix the sign afterwards. The real helpers
+; also pay the argument shuffle through __rc2.., which is left out, so
+; these are a lower bound on what the replaced code cost.
+;
+; Arguments and results live in rt_n (dividend or first factor in,
+; quotient out), rt_d (divisor or second factor) and rt_r (remainder or
+; product), little-endian, 4 bytes each; the 16-bit helpers use the low
+; two.
+
+.section .zp.bss.runtime,"zaw",@nobits
+rt_n:    .zero 4
+rt_d:    .zero 4
+rt_r:    .zero 4
+rt_sign: .zero 1
+rt_t:    .zero 1
+
+.section .text.runtime,"ax",@progbits
+
+; rt_r = rt_n * rt_d, 16-bit (signed and unsigned alike)
+__mulhi3:
+    stz mos8(rt_r)
+    stz mos8(rt_r+1)
+1:
+    lda mos8(rt_n)
+    ora mos8(rt_n+1)
+    beq 3f
+    lsr mos8(rt_n+1)
+    ror mos8(rt_n)
+    bcc 2f
+    clc
+    lda mos8(rt_r)
+    adc mos8(rt_d)
+    sta mos8(rt_r)
+    lda mos8(rt_r+1)
+    adc mos8(rt_d+1)
+    sta mos8(rt_r+1)
+2:
+    asl mos8(rt_d)
+    rol mos8(rt_d+1)
+    bra 1b
+3:
+    rts
+
+; rt_r = rt_n * rt_d, 32-bit (signed and unsigned alike)
+__mulsi3:
+    stz mos8(rt_r)
+    stz mos8(rt_r+1)
+    stz mos8(rt_r+2)
+    stz mos8(rt_r+3)
+1:
+    lda mos8(rt_n)
+    ora mos8(rt_n+1)
+    ora mos8(rt_n+2)
+    ora mos8(rt_n+3)
+    beq 3f
+    lsr mos8(rt_n+3)
+    ror mos8(rt_n+2)
+    ror mos8(rt_n+1)
+    ror mos8(rt_n)
+    bcc 2f
+    clc
+    ldx #0
+    ldy #4
+4:
+    lda mos8(rt_r),x
+    adc mos8(rt_d),x
+    sta mos8(rt_r),x
+    inx
+    dey
+    bne 4b
+2:
+    asl mos8(rt_d)
+    rol mos8(rt_d+1)
+    rol mos8(rt_d+2)
+    rol mos8(rt_d+3)
+    bra 1b
+3:
+    rts
+
+; unsigned rt_n / rt_d, 16-bit
+__udivhi3:
+    stz mos8(rt_r)
+    stz mos8(rt_r+1)
+    ldx #16
+1:
+    asl mos8(rt_n)
+    rol mos8(rt_n+1)
+    rol mos8(rt_r)
+    rol mos8(rt_r+1)
+    lda mos8(rt_r)
+    sec
+    sbc mos8(rt_d)
+    tay
+    lda mos8(rt_r+1)
+    sbc mos8(rt_d+1)
+    bcc 2f
+    sta mos8(rt_r+1)
+    sty mos8(rt_r)
+    inc mos8(rt_n)
+2:
+    dex
+    bne 1b
+    rts
+
+; signed rt_n / rt_d, 16-bit, truncating
+__divhi3:
+    lda mos8(rt_n+1)
+    eor mos8(rt_d+1)
+    sta mos8(rt_sign)
+    bit mos8(rt_n+1)
+    bpl 1f
+    ldx #rt_n
+    jsr rt_neg16
+1:
+    bit mos8(rt_d+1)
+    bpl 2f
+    ldx #rt_d
+    jsr rt_neg16
+2:
+    jsr __udivhi3
+    bit mos8(rt_sign)
+    bpl 3f
+    ldx #rt_n
+    jsr rt_neg16
+3:
+    rts
+
+; unsigned rt_n / rt_d, 32-bit
+__udivsi3:
+    stz mos8(rt_r)
+    stz mos8(rt_r+1)
+    stz mos8(rt_r+2)
+    stz mos8(rt_r+3)
+    ldx #32
+1:
+    asl mos8(rt_n)
+    rol mos8(rt_n+1)
+    rol mos8(rt_n+2)
+    rol mos8(rt_n+3)
+    rol mos8(rt_r)
+    rol mos8(rt_r+1)
+    rol mos8(rt_r+2)
+    rol mos8(rt_r+3)
+    lda mos8(rt_r)
+    sec
+    sbc mos8(rt_d)
+    sta mos8(rt_t)
+    lda mos8(rt_r+1)
+    sbc mos8(rt_d+1)
+    tay
+    lda mos8(rt_r+2)
+    sbc mos8(rt_d+2)
+    pha
+    lda mos8(rt_r+3)
+    sbc mos8(rt_d+3)
+    bcc 2f
+    sta mos8(rt_r+3)
+    pla
+    sta mos8(rt_r+2)
+    sty mos8(rt_r+1)
+    lda mos8(rt_t)
+    sta mos8(rt_r)
+    inc mos8(rt_n)
+    bra 3f
+2:
+    pla
+3:
+    dex
+    bne 1b
+    rts
+
+; signed rt_n / rt_d, 32-bit, truncating
+__divsi3:
+    lda mos8(rt_n+3)
+    eor mos8(rt_d+3)
+    pha
+    bit mos8(rt_n+3)
+    bpl 1f
+    ldx #rt_n
+    jsr rt_neg32
+1:
+    bit mos8(rt_d+3)
+    bpl 2f
+    ldx #rt_d
+    jsr rt_neg32
+2:
+    jsr __udivsi3
+    pla
+    bpl 3f
+    ldx #rt_n
+    jsr rt_neg32
+3:
+    rts
+
+; Negate the 16-bit value at zero page X
+rt_neg16:
+    sec
+    lda #0
+    sbc mos8(0),x
+    sta mos8(0),x
+    lda #0
+    sbc mos8(1),x
+    sta mos8(1),x
+    rts
+
+; Negate the 32-bit value at zero page X
+rt_neg32:
+    sec
+    ldy #4
+1:
+    lda #0
+    sbc mos8(0),x
+    sta mos8(0),x
+    inx
+    dey
+    bne 1b
+    rts
@@ -0,0 +1,73 @@
+import contextlib
+import io
+import os
+import subprocess
+import sys
+import tempfile
+
+import asm6502
+
+# Cycle benches on the host W65C02S core. Assembles 6502 sources together
+# with the tables gen_tables.py makes, builds run6502.cpp with the host
+# C++ compiler ($CXX, default c++) and runs routines in batches:
+#
+#   with Bench(["bench/orbit_solver.s", ...]) as b:
+#       for cycles, out in b.run([("solve_div", [lo, hi, ...]), ...]): ...
+#
+# Each routine takes its arguments from bench_args and leaves its results
+# in bench_out (see run6502.cpp). Sources are relative to this directory.
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+TOOLS = os.path.dirname(HERE)
+sys.path.insert(0, TOOLS)
+import gen_tables
+
+class BenchError(Exception):
+    pass
+
+class Bench:
+    def __init__(self, sources, cxx=None):
+        self.sources = [os.path.join(HERE, s) for s in sources]
+        self.cxx = cxx or os.environ.get("CXX", "c++")
+
+    def __enter__(self):
+        self.tmp = tempfile.TemporaryDirectory()
+        d = self.tmp.name
+        gen_tables.build_tables()
+        ordered = gen_tables.layout()
+        tables = os.path.join(d, "tables.s")
+        with contextlib.redirect_stdout(io.StringIO()):
+            gen_tables.generate_object(tables, ordered, gen_tables.report(ordered))
+        image, self.symbols = asm6502.assemble(self.sources + [tables])
+        self.img, self.sym = os.path.join(d, "bench.img"), os.path.join(d, "bench.sym")
+        asm6502.write(image, self.symbols, self.img, self.sym)
+        self.exe = os.path.join(d, "run6502")
+        try:
+            r = subprocess.run([self.cxx, "-O2", "-I", HERE, os.path.join(HERE, "run6502.cpp"), "-o", self.exe],
+                               capture_output=True)
+        except OSError as e:
+            self.tmp.cleanup()
+            raise BenchError(f"no host C++ compiler ({self.cxx}): {e}")
+        if r.returncode:
+            self.tmp.cleanup()
+            raise BenchError(r.stderr.decode(errors="replace"))
+        return self
+
+    def __exit__(self, *exc):
+        self.tmp.cleanup()
+
+    def run(self, calls):
+        # calls: [(routine, [byte, ...])] -> [(cycles, [out bytes])]
+        text = "".join(f"{name} {' '.join(str(b & 0xFF) for b in args)}\n" for name, args in calls)
+        r = subprocess.run([self.exe, self.img, self.sym], input=text.encode(), capture_output=True)
+        if r.returncode:
+            raise BenchError(r.stderr.decode(errors="replace"))
+        results = []
+        for line in r.stdout.decode().splitlines():
+            v = [int(w) for w in line.split()]
+            results.append((v[0], v[1:]))
+        return results
+
+def s16(v):
+    # Little-endian bytes of a 16-bit value
+    return [v & 0xFF, (v >> 8) & 0xFF]
@@ -0,0 +1,304 @@
+// W65C02S core with cycle counting, for host-side checks of the 6502
+// code in src/ (tools/kernel_equiv.py, the cycle benches). Binary mode
+// only: nothing here sets the decimal flag. Reads and writes at
+// 0xFFE0-0xFFFF go to io_read / io_write, where the RIA registers live.
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+
+struct Cpu6502 {
+    uint8_t mem[65536];
+    uint8_t a = 0, x = 0, y = 0, sp = 0xFF, p = 0x24;
+    uint16_t pc = 0;
+    unsigned long long cycles = 0;
+    std::map<std::string, unsigned> sym;
+    uint8_t (*io_read)(uint16_t) = nullptr;
+    void (*io_write)(uint16_t, uint8_t) = nullptr;
+
+    // Image and symbol files from asm6502.py
+    void load(const char *img, const char *syms) {
+        FILE *f = fopen(img, "rb");
+        if (!f || fread(mem, 1, sizeof mem, f) != sizeof mem) {
+            fprintf(stderr, "%s: not a 64 KB image\n", img);
+            exit(1);
+        }
+        fclose(f);
+        f = fopen(syms, "r");
+        if (!f) {
+            fprintf(stderr, "%s: cannot open\n", syms);
+            exit(1);
+        }
+        char name[256];
+        unsigned v;
+        while (fscanf(f, "%255s %u", name, &v) == 2) sym[name] = v;
+        fclose(f);
+    }
+
+    unsigned addr(const char *name) const {
+        auto it = sym.find(name);
+        if (it == sym.end()) {
+            fprintf(stderr, "no symbol %s\n", name);
+            exit(1);
+        }
+        return it->second;
+    }
+
+    // JSR to entry and run until the matching RTS. Returns the cycles
+    // spent, the JSR and RTS included.
+    unsigned long long call(uint16_t entry) {
+        unsigned long long c0 = cycles;
+        uint8_t sp0 = sp;
+        push(0xFF); // Returns to 0xFFFF, which ends the run
+        push(0xFE);
+        pc = entry;
+        cycles += 6;
+        while (pc != 0xFFFF) step();
+        sp = sp0;
+        return cycles - c0;
+    }
+
+    uint8_t rd(uint16_t ea) { return (ea >= 0xFFE0 && io_read) ? io_read(ea) : mem[ea]; }
+    void wr(uint16_t ea, uint8_t v) {
+        if (ea >= 0xFFE0 && io_write) io_write(ea, v);
+        else mem[ea] = v;
+    }
+
+private:
+    enum { C = 0x01, Z = 0x02, V = 0x40, N = 0x80 };
+
+    void nz(uint8_t v) { p = (p & ~(N | Z)) | (v & N) | (v ? 0 : Z); }
+    void setc(bool c) { p = (p & ~C) | (c ? C : 0); }
+    void push(uint8_t v) { mem[0x100 + sp--] = v; }
+    uint8_t pop() { return mem[0x100 + ++sp]; }
+    void adc(uint8_t v) {
+        unsigned r = a + v + (p & C);
+        p = (p & ~V) | ((~(a ^ v) & (a ^ r) & 0x80) ? V : 0);
+        setc(r > 0xFF);
+        a = (uint8_t)r;
+        nz(a);
+    }
+    void cmp(uint8_t r, uint8_t v) { setc(r >= v); nz((uint8_t)(r - v)); }
+    void bit(uint8_t v, bool imm) {
+        if (!imm) p = (p & ~(N | V)) | (v & (N | V));
+        p = (p & ~Z) | ((a & v) ? 0 : Z);
+    }
+    uint8_t shift(int kind, uint8_t v) {
+        bool c = p & C;
+        switch (kind) {
+        case 0: setc(v & 0x80); v <<= 1; break;                         // ASL
+        case 1: setc(v & 0x80); v = (uint8_t)((v << 1) | c); break;     // ROL
+        case 2: setc(v & 1); v >>= 1; break;                            // LSR
+        case 3: setc(v & 1); v = (uint8_t)((v >> 1) | (c << 7)); break; // ROR
+        case 4: v++; break;                                             // INC
+        case 5: v--; break;                                             // DEC
+        }
+        nz(v);
+        return v;
+    }
+
+    uint16_t word(uint16_t at) { return mem[at] | (mem[(uint16_t)(at + 1)] << 8); }
+    uint16_t zword(uint8_t at) { return mem[at] | (mem[(uint8_t)(at + 1)] << 8); }
+
+    void step() {
+        uint8_t op = mem[pc++];
+        uint16_t ea = 0;
+        bool cross = false;
+        auto indexed = [&](uint16_t base, uint8_t i) {
+            ea = base + i;
+            cross = (base ^ ea) & 0xFF00;
+        };
+        // Addressing modes leave the effective address in ea
+        auto m_imm = [&] { ea = pc++; };
+        auto m_zp = [&] { ea = mem[pc++]; };
+        auto m_zpx = [&] { ea = (uint8_t)(mem[pc++] + x); };
+        auto m_zpy = [&] { ea = (uint8_t)(mem[pc++] + y); };
+        auto m_abs = [&] { ea = word(pc); pc += 2; };
+        auto m_absx = [&] { indexed(word(pc), x); pc += 2; };
+        auto m_absy = [&] { indexed(word(pc), y); pc += 2; };
+        auto m_indx = [&] { ea = zword((uint8_t)(mem[pc++] + x)); };
+        auto m_indy = [&] { indexed(zword(mem[pc++]), y); };
+        auto m_ind = [&] { ea = zword(mem[pc++]); };
+        auto branch = [&](bool taken) {
+            int8_t off = (int8_t)mem[pc++];
+            cycles += 2;
+            if (taken) {
+                uint16_t to = pc + off;
+                cycles += 1 + (((to ^ pc) & 0xFF00) != 0);
+                pc = to;
+            }
+        };
+
+        // The eight addressing modes of the ALU group (aaa bbb 01)
+        if ((op & 0x03) == 0x01) {
+            switch ((op >> 2) & 7) {
+            case 0: m_indx(); cycles += 6; break;
+            case 1: m_zp(); cycles += 3; break;
+            case 2: m_imm(); cycles += 2; break;
+            case 3: m_abs(); cycles += 4; break;
+            case 4: m_indy(); cycles += 5; break;
+            case 5: m_zpx(); cycles += 4; break;
+            case 6: m_absy(); cycles += 4; break;
+            case 7: m_absx(); cycles += 4; break;
+            }
+            if (op >> 5 == 4) { // STA: no #imm, indexed stores always pay the fix-up
+                if (op == 0x89) { bit(mem[ea], true); return; } // BIT #imm sits in this slot
+                if (((op >> 2) & 7) >= 4 && ((op >> 2) & 7) != 5) cycles += 1;
+                wr(ea, a);
+                return;
+            }
+            cycles += cross;
+            alu(op >> 5, rd(ea));
+            return;
+        }
+
+        switch (op) {
+        // (zp) forms of the ALU group
+        case 0x12: case 0x32: case 0x52: case 0x72: case 0xB2: case 0xD2: case 0xF2:
+            m_ind(); cycles += 5; alu(op >> 5, rd(ea)); break;
+        case 0x92: m_ind(); cycles += 5; wr(ea, a); break;
+
+        case 0xA2: m_imm(); cycles += 2; x = rd(ea); nz(x); break;
+        case 0xA6: m_zp(); cycles += 3; x = rd(ea); nz(x); break;
+        case 0xB6: m_zpy(); cycles += 4; x = rd(ea); nz(x); break;
+        case 0xAE: m_abs(); cycles += 4; x = rd(ea); nz(x); break;
+        case 0xBE: m_absy(); cycles += 4 + cross; x = rd(ea); nz(x); break;
+        case 0xA0: m_imm(); cycles += 2; y = rd(ea); nz(y); break;
+        case 0xA4: m_zp(); cycles += 3; y = rd(ea); nz(y); break;
+        case 0xB4: m_zpx(); cycles += 4; y = rd(ea); nz(y); break;
+        case 0xAC: m_abs(); cycles += 4; y = rd(ea); nz(y); break;
+        case 0xBC: m_absx(); cycles += 4 + cross; y = rd(ea); nz(y); break;
+
+        case 0x86: m_zp(); cycles += 3; wr(ea, x); break;
+        case 0x96: m_zpy(); cycles += 4; wr(ea, x); break;
+        case 0x8E: m_abs(); cycles += 4; wr(ea, x); break;
+        case 0x84: m_zp(); cycles += 3; wr(ea, y); break;
+        case 0x94: m_zpx(); cycles += 4; wr(ea, y); break;
+        case 0x8C: m_abs(); cycles += 4; wr(ea, y); break;
+        case 0x64: m_zp(); cycles += 3; wr(ea, 0); break;
+        case 0x74: m_zpx(); cycles += 4; wr(ea, 0); break;
+        case 0x9C: m_abs(); cycles += 4; wr(ea, 0); break;
+        case 0x9E: m_absx(); cycles += 5; wr(ea, 0); break;
+
+        case 0xE0: m_imm(); cycles += 2; cmp(x, rd(ea)); break;
+        case 0xE4: m_zp(); cycles += 3; cmp(x, rd(ea)); break;
+        case 0xEC: m_abs(); cycles += 4; cmp(x, rd(ea)); break;
+        case 0xC0: m_imm(); cycles += 2; cmp(y, rd(ea)); break;
+        case 0xC4: m_zp(); cycles += 3; cmp(y, rd(ea)); break;
+        case 0xCC: m_abs(); cycles += 4; cmp(y, rd(ea)); break;
+
+        case 0x24: m_zp(); cycles += 3; bit(rd(ea), false); break;
+        case 0x2C: m_abs(); cycles += 4; bit(rd(ea), false); break;
+        case 0x34: m_zpx(); cycles += 4; bit(rd(ea), false); break;
+        case 0x3C: m_absx(); cycles += 4 + cross; bit(rd(ea), false); break;
+
+        // Shifts, INC and DEC: accumulator, zp, zp,x, abs, abs,x
+        case 0x0A: cycles += 2; a = shift(0, a); break;
+        case 0x2A: cycles += 2; a = shift(1, a); break;
+        case 0x4A: cycles += 2; a = shift(2, a); break;
+        case 0x6A: cycles += 2; a = shift(3, a); break;
+        case 0x1A: cycles += 2; a = shift(4, a); break;
+        case 0x3A: cycles += 2; a = shift(5, a); break;
+        case 0x06: case 0x26: case 0x46: case 0x66: case 0xE6: case 0xC6:
+            m_zp(); cycles += 5; wr(ea, shift(rmw_kind(op), rd(ea))); break;
+        case 0x16: case 0x36: case 0x56: case 0x76: case 0xF6: case 0xD6:
+            m_zpx(); cycles += 6; wr(ea, shift(rmw_kind(op), rd(ea))); break;
+        case 0x0E: case 0x2E: case 0x4E: case 0x6E: case 0xEE: case 0xCE:
+            m_abs(); cycles += 6; wr(ea, shift(rmw_kind(op), rd(ea))); break;
+        case 0x1E: case 0x3E: case 0x5E: case 0x7E:
+            m_absx(); cycles += 6 + cross; wr(ea, shift(rmw_kind(op), rd(ea))); break;
+        case 0xFE: case 0xDE:
+            m_absx(); cycles += 7; wr(ea, shift(rmw_kind(op), rd(ea))); break;
+        case 0x04: case 0x0C: case 0x14: case 0x1C: { // TSB, TRB
+            if (op & 0x08) { m_abs(); cycles += 6; } else { m_zp(); cycles += 5; }
+            uint8_t v = rd(ea);
+            p = (p & ~Z) | ((a & v) ? 0 : Z);
+            wr(ea, (op & 0x10) ? (v & ~a) : (v | a));
+        } break;
+
+        case 0x10: branch(!(p & N)); break;
+        case 0x30: branch(p & N); break;
+        case 0x50: branch(!(p & V)); break;
+        case 0x70: branch(p & V); break;
+        case 0x90: branch(!(p & C)); break;
+        case 0xB0: branch(p & C); break;
+        case 0xD0: branch(!(p & Z)); break;
+        case 0xF0: branch(p & Z); break;
+        case 0x80: branch(true); break; // BRA
+
+        case 0x18: cycles += 2; p &= ~C; break;
+        case 0x38: cycles += 2; p |= C; break;
+        case 0xB8: cycles += 2; p &= ~V; break;
+        case 0x58: case 0x78: case 0xD8: cycles += 2; break;
+        case 0xAA: cycles += 2; x = a; nz(x); break;
+        case 0x8A: cycles += 2; a = x; nz(a); break;
+        case 0xA8: cycles += 2; y = a; nz(y); break;
+        case 0x98: cycles += 2; a = y; nz(a); break;
+        case 0xBA: cycles += 2; x = sp; nz(x); break;
+        case 0x9A: cycles += 2; sp = x; break;
+        case 0xE8: cycles += 2; x++; nz(x); break;
+        case 0xCA: cycles += 2; x--; nz(x); break;
+        case 0xC8: cycles += 2; y++; nz(y); break;
+        case 0x88: cycles += 2; y--; nz(y); break;
+        case 0xEA: cycles += 2; break;
+
+        case 0x48: cycles += 3; push(a); break;
+        case 0xDA: cycles += 3; push(x); break;
+        case 0x5A: cycles += 3; push(y); break;
+        case 0x08: cycles += 3; push(p | 0x30); break;
+        case 0x68: cycles += 4; a = pop(); nz(a); break;
+        case 0xFA: cycles += 4; x = pop(); nz(x); break;
+        case 0x7A: cycles += 4; y = pop(); nz(y); break;
+        case 0x28: cycles += 4; p = pop() | 0x20; break;
+
+        case 0x4C: m_abs(); cycles += 3; pc = ea; break;
+        case 0x6C: m_abs(); cycles += 6; pc = word(ea); break;
+        case 0x7C: m_abs(); cycles += 6; pc = word((uint16_t)(ea + x)); break;
+        case 0x20: {
+            m_abs();
+            cycles += 6;
+            uint16_t ret = pc - 1;
+            push(ret >> 8);
+            push(ret & 0xFF);
+            pc = ea;
+        } break;
+        case 0x60: {
+            cycles += 6;
+            uint16_t lo = pop();
+            uint16_t hi = pop();
+            pc = ((hi << 8) | lo) + 1;
+        } break;
+
+        default:
+            fprintf(stderr, "unsupported opcode %02X at %04X\n", op, pc - 1);
+            exit(1);
+        }
+    }
+
+    static int rmw_kind(uint8_t op) {
+        switch (op >> 4) {
+        case 0x0: case 0x1: return 0;
+        case 0x2: case 0x3: return 1;
+        case 0x4: case 0x5: return 2;
+        case 0x6: case 0x7: return 3;
+        case 0xE: case 0xF: return 4;
+        default: return 5; // 0xC, 0xD
+        }
+    }
+
+    // ORA AND EOR ADC (STA) LDA CMP SBC
+    void alu(int kind, uint8_t v) {
+        switch (kind) {
+        case 0: a |= v; nz(a); break;
+        case 1: a &= v; nz(a); break;
+        case 2: a ^= v; nz(a); break;
+        case 3: adc(v); break;
+        case 5: a = v; nz(a); break;
+        case 6: cmp(a, v); break;
+        case 7: adc(~v); break;
+        }
+    }
+};
@@ -0,0 +1,169 @@
+// galaxy_tick on the host, for tools/kernel_equiv.py. Built twice around
+// src/galaxy.c: as is (the C particle loop), and with USE_ASM_PARTICLES,
+// where galaxy_particles_asm runs src/galaxy_kernel.s on the W65C02S core
+// against the same XRAM. Both runs see the same entities and blast, and
+// dump XRAM to stdout for the driver to compare.
+//
+// usage: kernel_equiv <frames> [<image> <symbols>]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rp6502.h"
+#include "galaxy.h"
+#include "sprites.h"
+#include "xram.h"
+#ifdef USE_ASM_PARTICLES
+#include "cpu6502.h"
+#include "galaxy_kernel.h"
+#endif
+
+uint8_t xram[0x10000];
+Ria RIA;
+
+// Entity state galaxy_tick reads; sprites.c is not built
+int16_t enemy_x[MAX_ENEMIES], enemy_y[MAX_ENEMIES];
+uint8_t enemy_active, enemy_live[MAX_ENEMIES], enemy_live_count;
+int16_t worker_x[MAX_WORKERS], worker_y[MAX_WORKERS];
+uint8_t worker_type[MAX_WORKERS], worker_active, worker_live[MAX_WORKERS], worker_live_count;
+uint8_t gardener_live[MAX_WORKERS], gardener_count;
+
+// XRAM block operations as plain loops, shared by both builds
+void xram_fill(uint16_t addr, uint16_t len, uint8_t value) {
+    while (len--) xram[addr++] = value;
+}
+void xram_copy(uint16_t dst, uint16_t src, uint16_t len) {
+    while (len--) xram[dst++] = xram[src++];
+}
+void xram_upload(uint16_t addr, const void *src, uint16_t len) {
+    const uint8_t *p = (const uint8_t *)src;
+    while (len--) xram[addr++] = *p++;
+}
+void xram_decay2(uint16_t addr, uint16_t count) {
+    for (; count--; addr += 2) xram[addr] = (xram[addr] >> 1) & 0x77;
+}
+void xram_decay2_4bpp(uint16_t addr, uint16_t count) {
+    for (; count--; addr += 2) xram[addr] = (xram[addr] >> 1) & 0x55;
+}
+void xram_decay2x(uint16_t dst, uint16_t src, uint16_t count) {
+    for (; count--; src += 2) {
+        uint8_t v = (xram[src] >> 1) & 0x77;
+        xram[dst++] = v;
+        xram[dst++] = v;
+    }
+}
+void xram_unlz(uint16_t dst, uint16_t src) {
+    fprintf(stderr, "xram_unlz is not modelled\n");
+    exit(1);
+}
+
+#ifdef USE_ASM_PARTICLES
+static Cpu6502 cpu;
+static unsigned long long kernel_cycles, kernel_calls, kernel_steps;
+
+// RIA registers as galaxy_kernel.s addresses them
+static uint8_t ria_read(uint16_t a) {
+    switch (a) {
+    case 0xFFE4: return RIA.rw0;
+    case 0xFFE5: return (uint8_t)RIA.step0.v;
+    case 0xFFE6: return RIA.addr0.v & 0xFF;
+    case 0xFFE7: return RIA.addr0.v >> 8;
+    case 0xFFE8: return RIA.rw1;
+    case 0xFFE9: return (uint8_t)RIA.step1.v;
+    case 0xFFEA: return RIA.addr1.v & 0xFF;
+    case 0xFFEB: return RIA.addr1.v >> 8;
+    }
+    return 0;
+}
+
+static void ria_write(uint16_t a, uint8_t v) {
+    switch (a) {
+    case 0xFFE4: RIA.rw0 = v; break;
+    case 0xFFE5: RIA.step0 = (int8_t)v; break;
+    case 0xFFE6: RIA.addr0.v = (RIA.addr0.v & 0xFF00) | v; break;
+    case 0xFFE7: RIA.addr0.v = (RIA.addr0.v & 0x00FF) | (v << 8); break;
+    case 0xFFE8: RIA.rw1 = v; break;
+    case 0xFFE9: RIA.step1 = (int8_t)v; break;
+    case 0xFFEA: RIA.addr1.v = (RIA.addr1.v & 0xFF00) | v; break;
+    case 0xFFEB: RIA.addr1.v = (RIA.addr1.v & 0x00FF) | (v << 8); break;
+    }
+}
+
+// The kernel reads galaxy_kernel and BLEND_LUT from 6502 memory: copy the
+// struct in and out around each call, and point lut_page at the image's
+// own BLEND_LUT (tables.s assembled alongside the kernel).
+void galaxy_particles_asm(uint8_t count) {
+    unsigned gk = cpu.addr("galaxy_kernel");
+    galaxy_kernel.lut_page = (uint8_t)(cpu.addr("BLEND_LUT") >> 8);
+    memcpy(&cpu.mem[gk], &galaxy_kernel, sizeof galaxy_kernel);
+    cpu.a = count;
+    kernel_cycles += cpu.call(cpu.addr("galaxy_particles_asm"));
+    memcpy(&galaxy_kernel, &cpu.mem[gk], sizeof galaxy_kernel);
+    kernel_calls++;
+    kernel_steps += count;
+}
+#endif
+
+// Three enemies and three workers (two gardeners) on fixed drifting
+// paths, one enemy and one gardener partly off screen, so zone clipping
+// and the later-zone-wins order are both exercised.
+static void place_entities(int frame) {
+    static const int16_t ex[] = {150, 40, -6}, ey[] = {80, 120, 30};
+    static const int16_t wx[] = {120, 200, 310}, wy[] = {90, 60, 170};
+    static const uint8_t wt[] = {1, 0, 1};
+
+    enemy_active = worker_active = 0;
+    enemy_live_count = worker_live_count = gardener_count = 0;
+    for (uint8_t e = 0; e < 3; e++) {
+        enemy_x[e] = (int16_t)((ex[e] + (frame * (e + 1)) % 64) << 4);
+        enemy_y[e] = (int16_t)((ey[e] + (frame * 3) % 40) << 4);
+        enemy_active |= 1 << e;
+        enemy_live[enemy_live_count++] = e;
+    }
+    for (uint8_t w = 0; w < 3; w++) {
+        worker_x[w] = (int16_t)((wx[w] - (frame * 2) % 48) << 4);
+        worker_y[w] = (int16_t)((wy[w] + (frame * (w + 1)) % 24) << 4);
+        worker_type[w] = wt[w];
+        worker_active |= 1 << w;
+        worker_live[worker_live_count++] = w;
+        if (wt[w] == 1) gardener_live[gardener_count++] = w;
+    }
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 30;
+#ifdef USE_ASM_PARTICLES
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s <frames> <image> <symbols>\n", argv[0]);
+        return 2;
+    }
+    cpu.load(argv[2], argv[3]);
+    cpu.io_read = ria_read;
+    cpu.io_write = ria_write;
+#endif
+
+    galaxy_init();
+    while (!galaxy_clear_step()) {}
+    galaxy_randomize(4242);
+    place_entities(0);
+
+    // One blast on frame 2. It stays live for 21 frames, during which the
+    // asm build runs the C loop too, so the handover both ways is covered.
+    long ticks = 0;
+    for (int f = 0; f < frames; ticks++) {
+        if (!galaxy_tick()) continue;
+        f++;
+        place_entities(f);
+        if (f == 2) galaxy_explosion(160, 90, 1);
+    }
+
+    fwrite(xram, 1, sizeof xram, stdout);
+    fprintf(stderr, "%d frames, %ld ticks\n", frames, ticks);
+#ifdef USE_ASM_PARTICLES
+    if (kernel_steps) {
+        fprintf(stderr, "kernel: %llu calls, %llu steps, %.1f cycles/step, %.0f cycles/call\n",
+                kernel_calls, kernel_steps, (double)kernel_cycles / kernel_steps,
+                (double)kernel_cycles / kernel_calls);
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Host stand-in for the llvm-mos <rp6502.h>, so src/*.c can be built as
+// C++ on the host against a 64 KB XRAM array. Only the RIA portals are
+// modelled: rw0/rw1 read or write xram[addr] and then add step, as on
+// the hardware. xreg calls are dropped.
+#ifndef SIM6502_RP6502_H
+#define SIM6502_RP6502_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+extern uint8_t xram[0x10000];
+
+struct RiaAddr {
+    uint16_t v;
+    RiaAddr &operator=(unsigned a) { v = (uint16_t)a; return *this; }
+    RiaAddr &operator+=(int d) { v = (uint16_t)(v + d); return *this; }
+    RiaAddr &operator-=(int d) { v = (uint16_t)(v - d); return *this; }
+    operator uint16_t() const { return v; }
+};
+
+struct RiaStep {
+    int8_t v;
+    RiaStep &operator=(int s) { v = (int8_t)s; return *this; }
+    operator int8_t() const { return v; }
+};
+
+struct RiaPortal {
+    RiaAddr *addr;
+    RiaStep *step;
+    operator uint8_t() {
+        uint8_t r = xram[addr->v];
+        addr->v = (uint16_t)(addr->v + step->v);
+        return r;
+    }
+    RiaPortal &operator=(unsigned b) {
+        xram[addr->v] = (uint8_t)b;
+        addr->v = (uint16_t)(addr->v + step->v);
+        return *this;
+    }
+};
+
+struct Ria {
+    RiaAddr addr0, addr1;
+    RiaStep step0, step1;
+    RiaPortal rw0, rw1;
+    uint8_t vsync;
+    Ria() : addr0{0}, addr1{0}, step0{1}, step1{1}, rw0{&addr0, &step0}, rw1{&addr1, &step1}, vsync(0) {}
+};
+
+extern Ria RIA;
+
+#define xregn(...) ((void)0)
+#define xreg(...) ((void)0)
+#define xram0_struct_set(addr, type, member, val) \
+    do { RIA.addr0 = (unsigned)offsetof(type, member) + (unsigned)(addr); RIA.step0 = 1; RIA.rw0 = (uint8_t)(val); } while (0)
+
+typedef struct { bool x_wrap, y_wrap; int16_t x_pos_px, y_pos_px, width_px, height_px; uint16_t xram_data_ptr, xram_palette_ptr; } vga_mode3_config_t;
+typedef struct { int16_t x_pos_px, y_pos_px; uint16_t xram_sprite_ptr; uint8_t log_size; bool has_opacity_metadata; } vga_mode4_sprite_t;
+typedef struct { int16_t transform[6]; int16_t x_pos_px, y_pos_px; uint16_t xram_sprite_ptr; uint8_t log_size; bool has_opacity_metadata; } vga_mode4_asprite_t;
+
+#endif
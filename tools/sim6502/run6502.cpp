@@ -0,0 +1,41 @@
+// Cycle-count runner for the benches (tools/sim6502/bench6502.py). Loads
+// an asm6502.py image and runs one routine per stdin line:
+//
+//   <routine> <byte> <byte> ...
+//
+// The bytes go to bench_args, the routine is called, and the line printed
+// back is the cycle count (JSR and RTS included) followed by the first
+// BENCH_OUT bytes of bench_out.
+//
+// usage: run6502 <image> <symbols>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpu6502.h"
+
+#define BENCH_OUT 32
+
+static Cpu6502 cpu;
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <image> <symbols>\n", argv[0]);
+        return 2;
+    }
+    cpu.load(argv[1], argv[2]);
+    unsigned args = cpu.addr("bench_args"), out = cpu.addr("bench_out");
+
+    char line[1024];
+    while (fgets(line, sizeof line, stdin)) {
+        char *tok = strtok(line, " \t\r\n");
+        if (!tok) continue;
+        unsigned entry = cpu.addr(tok);
+        unsigned n = 0;
+        while ((tok = strtok(NULL, " \t\r\n"))) cpu.mem[args + n++] = (uint8_t)strtol(tok, NULL, 0);
+        unsigned long long c = cpu.call((uint16_t)entry);
+        printf("%llu", c);
+        for (unsigned i = 0; i < BENCH_OUT; i++) printf(" %u", cpu.mem[out + i]);
+        putchar('\n');
+    }
+    return 0;
+}